@@ -10,33 +10,46 @@ constexpr BoardHooks kExampleHooks{
     nullptr   // afterWake
 };
 
-// Example sensors table; add entries as real sensors are implemented.
-constexpr AnalogSensorContext kExampleAnalog0{
+// Example sensors table; add entries as real sensors are implemented. Tables,
+// contexts and names are placed in mapped flash to save SRAM.
+constexpr char kExampleAnalog0Name[] BAJACAN_FLASH_TABLE = "AnalogRaw0";
+constexpr char kExampleAnalog1Name[] BAJACAN_FLASH_TABLE = "AnalogRaw1";
+
+constexpr AnalogSensorContext kExampleAnalog0 BAJACAN_FLASH_TABLE{
     .base =
         {
-            .name = "AnalogRaw0",
+            .name = kExampleAnalog0Name,
             .canId = 0x300,
             .pollIntervalMs = 5,
+            .sampleCostUs = 5,
         },
     .pin = 19,  // PD7
+    .mode = AnalogMode::Scan,
 };
-constexpr AnalogSensorContext kExampleAnalog1{
+constexpr AnalogSensorContext kExampleAnalog1 BAJACAN_FLASH_TABLE{
     .base = 
         {
-            .name = "AnalogRaw1",
+            .name = kExampleAnalog1Name,
             .canId = 0x200,
             .pollIntervalMs = 5,
+            .sampleCostUs = 5,
         },
     .pin = 17, // PD5
+    .mode = AnalogMode::Scan,
+    .accumulateLog2 = 4,  // 16 samples per poll...
+    .extraBits = 2,       // ...decimated to a 14-bit reading.
 };
 
-constexpr SensorDescriptor kExampleSensors[] = {
+static_assert(AnalogSensorSettingsValid(kExampleAnalog1),
+              "Analog oversampling needs 4^extraBits accumulated samples");
+
+constexpr SensorDescriptor kExampleSensors[] BAJACAN_FLASH_TABLE = {
     MakeAnalogSensor(&kExampleAnalog0),
     MakeAnalogSensor(&kExampleAnalog1),
 };
 
 // Example board configuration demonstrating default CAN wiring and control IDs.
-constexpr BoardConfig kBoardConfig{
+constexpr BoardConfig kBoardConfig BAJACAN_FLASH_TABLE{
     kDefaultCanCsPin,
     kDefaultCanIntPin,
     kDefaultCanStbyPin,
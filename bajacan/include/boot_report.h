@@ -0,0 +1,78 @@
+// Boot path helpers: reset-cause capture for fast boot, and an optional
+// time-to-first-frame report.
+//
+// Fast boot (-DBAJACAN_FAST_BOOT=1, the default) does two things:
+// - After a warm reset (watchdog, software, reset pin or UPDI) the MCP251863
+//   stayed powered and passed its SPI read-back tests on an earlier boot, so
+//   ConfigureCan() skips them. Power-on, brown-out and unknown resets still
+//   run them.
+// - ACAN2517FD::begin() returns right after requesting NormalFD, and the
+//   controller integrates to the bus while the sensor begin hooks run.
+//
+// With -DBAJACAN_ENABLE_BOOT_REPORT=1, a 24-byte frame goes out on the ID
+// given to BootReportBegin() once the first sensor frame is queued.
+// Big-endian layout:
+//   [0] reset flags (RSTCTRL.RSTFR layout)  [1] bit 0: read-back tests skipped
+//   [2..21] micros() when each BootPhase ended, in enum order, 4 bytes each
+//   [22..23] zero
+// micros() starts counting in the core's init(). Startup code that runs
+// before init() is not included.
+
+#pragma once
+
+#include <Arduino.h>
+#include <ACAN2517FD.h>
+#include <stdint.h>
+
+#ifndef BAJACAN_FAST_BOOT
+#define BAJACAN_FAST_BOOT 1
+#endif
+
+#ifndef BAJACAN_ENABLE_BOOT_REPORT
+#define BAJACAN_ENABLE_BOOT_REPORT 0
+#endif
+
+enum class BootPhase : uint8_t {
+  SetupStart,
+  CanConfigured,   // ACAN2517FD::begin() returned.
+  SensorsStarted,  // Every sensor begin hook ran.
+  CanReady,        // Controller reached NormalFD.
+  FirstFrame,      // First sensor frame queued for TX.
+  Count,
+};
+
+// Returns this boot's RSTCTRL.RSTFR flags, as saved in GPIOR0 by the core's
+// startup code, and clears them so the next boot sees only its own cause.
+// Call first thing in setup().
+uint8_t BootCaptureResetFlags();
+
+// True when the reset described by `flags` left the MCP251863 powered. No
+// flags means the cause is unknown, which counts as a cold boot.
+constexpr bool BootIsWarmReset(const uint8_t flags) {
+  return flags != 0U && (flags & (RSTCTRL_PORF_bm | RSTCTRL_BORF_bm)) == 0U;
+}
+
+#if BAJACAN_ENABLE_BOOT_REPORT
+// Stores what the report needs from setup(): the reset cause, whether the
+// read-back tests were skipped, and the frame's ID (main.cpp passes
+// kBoardConfig.diagnostics.bootReportId and useExtendedIds).
+void BootReportBegin(uint8_t resetFlags, bool skippedSelfTest,
+                     uint32_t reportId, bool useExtendedIds);
+// Records micros() the first time `phase` is marked; later calls are ignored.
+void BootReportMark(BootPhase phase);
+// True once FirstFrame is marked, until BootReportSent().
+bool BootReportPending();
+void BootReportBuild(CANFDMessage &outFrame);
+void BootReportSent();
+#else
+inline void BootReportBegin(const uint8_t resetFlags,
+                            const bool skippedSelfTest,
+                            const uint32_t reportId,
+                            const bool useExtendedIds) {
+  (void)resetFlags;
+  (void)skippedSelfTest;
+  (void)reportId;
+  (void)useExtendedIds;
+}
+inline void BootReportMark(const BootPhase phase) { (void)phase; }
+#endif
@@ -6,8 +6,22 @@
 #pragma once
 
 #include <ACAN2517FD.h>
+#include <Arduino.h>
 #include <stdint.h>
 
+// Put on constexpr board tables (contexts, descriptor arrays, kBoardConfig,
+// sensor name strings, calibration tables) to keep them out of SRAM:
+//   constexpr AnalogSensorContext kThrottle BAJACAN_FLASH_TABLE{...};
+// avr-gcc copies const data into SRAM at startup on the 128 KB DB parts.
+// DxCore's PROGMEM_MAPPED places it in the 32 KB flash window mapped into the
+// data space instead, where it is read with ordinary loads, so nothing that
+// reads it changes. Mutable sensor state must stay in RAM.
+#if defined(PROGMEM_MAPPED)
+#define BAJACAN_FLASH_TABLE PROGMEM_MAPPED
+#else
+#define BAJACAN_FLASH_TABLE
+#endif
+
 // Optional board-level hooks that may be provided by a board config. Any
 // callback may be set to nullptr when unused.
 struct BoardHooks {
@@ -31,11 +45,86 @@ constexpr ControlMessageConfig kDefaultControlCommands{
     0     // commandByteIndex
 };
 
+// CAN IDs used by the optional on-node diagnostics (see sensor_stats.h,
+// loop_profiler.h and boot_report.h).
+struct DiagnosticsConfig {
+  uint32_t requestId;   // Inbound frames on this ID ask for a diagnostics dump.
+  uint32_t responseId;  // ID the node answers on.
+  uint32_t profilerId;  // ID for periodic loop profiler reports.
+  uint32_t bootReportId;  // ID for the one-shot boot timing report.
+};
+
+constexpr DiagnosticsConfig kDefaultDiagnostics{
+    0x7F0,  // requestId
+    0x7F1,  // responseId
+    0x7F2,  // profilerId
+    0x7F3   // bootReportId
+};
+
 // Required per-sensor metadata carried in each sensor's context.
 struct SensorContext {
   const char *name;
   uint32_t canId;          // CAN ID the sampled payload should be sent on.
   uint16_t pollIntervalMs; // How often to poll/sample the sensor.
+  uint16_t sampleCostUs;   // Expected sample() duration; used to plan phases.
+  // Optional change-triggered transmission, enabled when maxSilenceMs > 0: a
+  // sampled frame is only sent if some big-endian 16-bit payload field moved
+  // by more than deadband since the last sent frame, or maxSilenceMs passed.
+  // Frames longer than 8 bytes are always sent.
+  uint16_t deadband;
+  uint16_t maxSilenceMs;
+  // Two-phase sensors only: time from startConversion until collect can
+  // succeed. Conversions start this long before each poll is due.
+  uint16_t conversionMs;
+};
+
+// Result of SensorDescriptor::collect.
+enum class SensorCollectResult : uint8_t {
+  Pending,  // Not done yet; collect is called again on the next loop pass.
+  Ready,    // outFrame holds the sample.
+  Failed,   // Nothing to send this period.
+};
+// Protothread waits return a value-initialized result (protothread.h).
+static_assert(SensorCollectResult{} == SensorCollectResult::Pending,
+              "Pending must be the zero value");
+
+// Most frames one sampleBatch call may produce.
+constexpr uint8_t kSensorMaxBatchFrames = 4;
+
+// Frames produced by one SensorDescriptor::sampleBatch call; the core sends
+// them to the CAN driver together, in order.
+class SensorFrameBatch {
+ public:
+  // Empties the batch; frames added later default to `id` and `ext`.
+  void reset(const uint32_t id, const bool ext) {
+    count_ = 0;
+    defaultId_ = id;
+    ext_ = ext;
+  }
+
+  // Appends an empty frame on `id` and returns it, or nullptr when full.
+  CANFDMessage *add(const uint32_t id) {
+    if (count_ == kSensorMaxBatchFrames) {
+      return nullptr;
+    }
+    CANFDMessage &frame = frames_[count_++];
+    frame.id = id;
+    frame.ext = ext_;
+    frame.len = 0;
+    return &frame;
+  }
+
+  // Appends an empty frame on the sensor's own canId.
+  CANFDMessage *add() { return add(defaultId_); }
+
+  uint8_t size() const { return count_; }
+  const CANFDMessage *frames() const { return frames_; }
+
+ private:
+  CANFDMessage frames_[kSensorMaxBatchFrames];
+  uint8_t count_ = 0;
+  uint32_t defaultId_ = 0;
+  bool ext_ = false;
 };
 
 // Contract that each sensor driver entry must satisfy. Board configs supply a
@@ -43,11 +132,65 @@ struct SensorContext {
 // must begin with a SensorContext so the core app can read common metadata.
 struct SensorDescriptor {
   const void *context;       // Driver config or instance; must include SensorContext.
+  const SensorContext *base; // The SensorContext inside context, typed so it
+                             // can be read in constant expressions.
   bool (*begin)(const void *ctx);  // Called once during setup.
   bool (*sample)(const void *ctx,
                  CANFDMessage &outFrame);  // Should fill outFrame for sending.
   void (*suspend)(const void *ctx);        // Optional; called before sleep.
   void (*resume)(const void *ctx);         // Optional; called after wake.
+  // Optional; makes the sensor event-driven. Called once after begin with an
+  // ISR-safe callback the driver must invoke (typically by attaching it to
+  // its data-ready pin) whenever a new sample is available. The main loop then
+  // samples the sensor on its next pass; a non-zero pollIntervalMs becomes a
+  // fallback poll that restarts on every event. suspend/resume should
+  // detach/re-attach the interrupt if the pin can fire while asleep.
+  void (*attachDataReady)(const void *ctx, void (*onReady)());
+  // Optional two-phase sampling for sensors with a conversion time; when both
+  // are set they replace sample. startConversion kicks off a conversion and
+  // returns without waiting (false: no sample this period). collect runs from
+  // base->conversionMs later, once per loop pass, until it stops returning
+  // Pending; still Pending one pollIntervalMs after the poll was due counts as
+  // Failed, cancel is called and the next conversion starts on schedule. Not
+  // combined with attachDataReady.
+  bool (*startConversion)(const void *ctx);
+  SensorCollectResult (*collect)(const void *ctx, CANFDMessage &outFrame);
+  // Optional; abandons the conversion in flight (e.g. aborts a bus transfer
+  // that never finished) so the next startConversion can succeed.
+  void (*cancel)(const void *ctx);
+  // Optional; replaces sample for sensors whose one hardware read yields
+  // several frames (more samples than fit one frame, or one signal per CAN
+  // ID). Fill frames from outFrames.add(); return false to send nothing.
+  // Change-triggered transmission does not apply to batches.
+  bool (*sampleBatch)(const void *ctx, SensorFrameBatch &outFrames);
+};
+
+// CAN buffer sizing applied to ACAN2517FDSettings. Controller FIFOs live in
+// the MCP251863's 2 KB message RAM; driver FIFOs are CANFDMessage rings the
+// driver allocates from AVR SRAM in begin(). Both are budget-checked at
+// compile time (ram_budget.h).
+struct CanBufferConfig {
+  uint16_t driverTransmitFifoSize;      // >= 0
+  uint8_t controllerTransmitFifoSize;  // 1..32
+  ACAN2517FDSettings::PayloadSize controllerTransmitFifoPayload;
+  uint8_t controllerTxqSize;  // 0..32; 0 disables the TXQ.
+  ACAN2517FDSettings::PayloadSize controllerTxqPayload;
+  uint16_t driverReceiveFifoSize;      // >= 1
+  uint8_t controllerReceiveFifoSize;  // 1..32
+  ACAN2517FDSettings::PayloadSize controllerReceiveFifoPayload;
+};
+
+// The ACAN2517FD library defaults: 2016 of 2048 controller bytes and 48
+// driver frames (~3.4 KB of SRAM).
+constexpr CanBufferConfig kDefaultCanBuffers{
+    16,                                // driverTransmitFifoSize
+    1,                                 // controllerTransmitFifoSize
+    ACAN2517FDSettings::PAYLOAD_64,    // controllerTransmitFifoPayload
+    0,                                 // controllerTxqSize
+    ACAN2517FDSettings::PAYLOAD_64,    // controllerTxqPayload
+    32,                                // driverReceiveFifoSize
+    27,                                // controllerReceiveFifoSize
+    ACAN2517FDSettings::PAYLOAD_64,    // controllerReceiveFifoPayload
 };
 
 // Aggregates the board-specific static data needed by the generic app.
@@ -63,6 +206,8 @@ struct BoardConfig {
   BoardHooks hooks;
   const SensorDescriptor *sensors;
   size_t sensorCount;
+  CanBufferConfig canBuffers = kDefaultCanBuffers;
+  DiagnosticsConfig diagnostics = kDefaultDiagnostics;
 };
 
 // Common CAN defaults shared across boards; override any field in kBoardConfig
@@ -0,0 +1,82 @@
+// Just enough constexpr math to compute filter coefficients and calibration
+// tables at compile time. Accurate to float precision (double is 32-bit on
+// AVR) over the ranges the sensor libraries use; never called at runtime.
+
+#pragma once
+
+#include <stdint.h>
+
+constexpr double kCxPi = 3.14159265358979323846;
+constexpr double kCxLn2 = 0.69314718055994530942;
+
+constexpr double CxAbs(const double x) { return x < 0 ? -x : x; }
+
+constexpr int32_t CxRound(const double x) {
+  return static_cast<int32_t>(x < 0 ? x - 0.5 : x + 0.5);
+}
+
+// Halves x until the Taylor series converges fast, then squares back up.
+constexpr double CxExp(const double x) {
+  double reduced = x;
+  uint8_t halvings = 0;
+  while (CxAbs(reduced) > 0.5) {
+    reduced /= 2;
+    ++halvings;
+  }
+  double sum = 1;
+  double term = 1;
+  for (uint8_t n = 1; n < 16; ++n) {
+    term *= reduced / n;
+    sum += term;
+  }
+  for (uint8_t i = 0; i < halvings; ++i) {
+    sum *= sum;
+  }
+  return sum;
+}
+
+// Natural log for x > 0: x = m * 2^e with m in [0.5, 1), then
+// ln(m) = 2 * atanh((m - 1) / (m + 1)).
+constexpr double CxLog(const double x) {
+  if (x <= 0) {
+    return 0;
+  }
+  double m = x;
+  int16_t e = 0;
+  while (m >= 1) {
+    m /= 2;
+    ++e;
+  }
+  while (m < 0.5) {
+    m *= 2;
+    --e;
+  }
+  const double z = (m - 1) / (m + 1);
+  const double z2 = z * z;
+  double term = z;
+  double sum = 0;
+  for (uint8_t n = 1; n < 40; n += 2) {
+    sum += term / n;
+    term *= z2;
+  }
+  return 2 * sum + e * kCxLn2;
+}
+
+constexpr double CxSin(const double x) {
+  double r = x;
+  while (r > kCxPi) {
+    r -= 2 * kCxPi;
+  }
+  while (r < -kCxPi) {
+    r += 2 * kCxPi;
+  }
+  double sum = 0;
+  double term = r;
+  for (uint8_t n = 1; n < 30; n += 2) {
+    sum += term;
+    term *= -r * r / ((n + 1) * (n + 2));
+  }
+  return sum;
+}
+
+constexpr double CxCos(const double x) { return CxSin(x + kCxPi / 2); }
@@ -0,0 +1,92 @@
+// Optional cycle-accurate profiler for the phases of loop(). Enable with
+// -DBAJACAN_ENABLE_LOOP_PROFILER=1; when disabled LoopPhaseScope is an empty
+// object and every call below compiles to nothing.
+//
+// Timing uses a TCB (TCBn for n = BAJACAN_PROFILER_TCB_INDEX, TCB1 by default)
+// free-running at CLK_PER, so one tick is one CPU cycle. Its wrap interrupt
+// extends the count to 32 bits, so phases up to ~179 s at 24 MHz are timed
+// correctly.
+//
+// Every kLoopProfilerReportMs a 64-byte frame is sent on the ID given to
+// LoopProfilerBegin() and the counters restart. It holds one 10-byte record
+// per LoopPhase, in enum order, big-endian, then 4 zero bytes:
+//   [0..3] total cycles (saturating)  [4..7] worst single call
+//   [8..9] call count
+// PollSensors is inclusive of the CanTx and DebugPrints phases it contains.
+
+#pragma once
+
+#include <Arduino.h>
+#include <ACAN2517FD.h>
+#include <stdint.h>
+
+#ifndef BAJACAN_ENABLE_LOOP_PROFILER
+#define BAJACAN_ENABLE_LOOP_PROFILER 0
+#endif
+
+// n selects TCBn and its TCBn_INT_vect. pulse_sensor checks its timers
+// against this index, so the timer is only ever chosen here.
+#ifndef BAJACAN_PROFILER_TCB_INDEX
+#define BAJACAN_PROFILER_TCB_INDEX 1
+#endif
+
+#define BAJACAN_PROFILER_PASTE(a, b, c) a##b##c
+#define BAJACAN_PROFILER_NAME(a, b, c) BAJACAN_PROFILER_PASTE(a, b, c)
+#define BAJACAN_PROFILER_TCB \
+  BAJACAN_PROFILER_NAME(TCB, BAJACAN_PROFILER_TCB_INDEX, )
+#define BAJACAN_PROFILER_TCB_VECT \
+  BAJACAN_PROFILER_NAME(TCB, BAJACAN_PROFILER_TCB_INDEX, _INT_vect)
+
+enum class LoopPhase : uint8_t {
+  ServiceIncomingCan,
+  WakeIfRequested,
+  PollSensors,
+  CanTx,
+  DebugPrints,
+  Loop,  // Whole awake pass through loop().
+  Count,
+};
+
+constexpr uint32_t kLoopProfilerReportMs = 1000;
+
+#if BAJACAN_ENABLE_LOOP_PROFILER
+// Starts the cycle timer. main.cpp passes kBoardConfig.diagnostics.profilerId
+// and useExtendedIds to address the report.
+void LoopProfilerBegin(uint32_t reportId, bool useExtendedIds);
+void LoopProfilerRecord(LoopPhase phase, uint32_t startTicks);
+// Builds the report frame and restarts the counters.
+void LoopProfilerBuildReport(CANFDMessage &outFrame);
+
+// Current 32-bit cycle count.
+uint32_t LoopProfilerNow();
+
+class LoopPhaseScope {
+ public:
+  explicit LoopPhaseScope(const LoopPhase phase)
+      : phase_(phase), start_(LoopProfilerNow()), active_(true) {}
+  ~LoopPhaseScope() {
+    if (active_) {
+      LoopProfilerRecord(phase_, start_);
+    }
+  }
+  // Drop this measurement, e.g. when the pass ends in sleep.
+  void discard() { active_ = false; }
+
+ private:
+  const LoopPhase phase_;
+  const uint32_t start_;
+  bool active_;
+};
+#else
+inline void LoopProfilerBegin(const uint32_t reportId,
+                              const bool useExtendedIds) {
+  (void)reportId;
+  (void)useExtendedIds;
+}
+
+class LoopPhaseScope {
+ public:
+  explicit LoopPhaseScope(const LoopPhase phase) { (void)phase; }
+  void discard() {}
+};
+#endif
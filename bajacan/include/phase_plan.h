@@ -0,0 +1,155 @@
+// Compile-time assignment of first-poll offsets for a board's sensors. The
+// planner simulates every periodic sensor over the hyperperiod of their poll
+// intervals and greedily picks, for each sensor, the offset that keeps the
+// number of frames queued in any single 1 ms tick (and then the summed sample
+// cost in that tick) as low as possible.
+
+#pragma once
+
+#include <config.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef BAJACAN_REPORT_PHASE_PLAN
+#define BAJACAN_REPORT_PHASE_PLAN 0
+#endif
+
+// Longest schedule the planner simulates. Boards whose intervals have a longer
+// hyperperiod are planned over this window only; offsets stay valid but the
+// reported peak may be optimistic.
+constexpr uint16_t kPhasePlanMaxWindowMs = 1000;
+
+template <size_t N>
+struct SensorPhasePlan {
+  uint16_t offsetMs[N];      // Delay from (re)start to each sensor's first poll.
+  uint16_t windowMs;         // Length of the simulated schedule.
+  uint8_t peakFramesPerMs;   // Worst number of frames queued in one 1 ms tick.
+  uint32_t peakCostUsPerMs;  // Worst summed sampleCostUs in one 1 ms tick.
+};
+
+namespace phase_plan_detail {
+
+constexpr uint32_t Gcd(uint32_t a, uint32_t b) {
+  while (b != 0U) {
+    const uint32_t rest = a % b;
+    a = b;
+    b = rest;
+  }
+  return a;
+}
+
+// Event-driven sensors fire on their own clock and are left out of the plan.
+constexpr bool IsPlanned(const SensorDescriptor &desc) {
+  return desc.base != nullptr && desc.base->pollIntervalMs > 0U &&
+         desc.attachDataReady == nullptr;
+}
+
+constexpr uint16_t PlanWindowMs(const SensorDescriptor *sensors,
+                                const size_t count) {
+  uint32_t window = 1;
+  for (size_t i = 0; i < count; ++i) {
+    if (!IsPlanned(sensors[i])) {
+      continue;
+    }
+    const uint32_t interval = sensors[i].base->pollIntervalMs;
+    window = window / Gcd(window, interval) * interval;
+    if (window > kPhasePlanMaxWindowMs) {
+      return kPhasePlanMaxWindowMs;
+    }
+  }
+  return static_cast<uint16_t>(window);
+}
+
+// Next sensor to place: shortest interval first since it has the fewest free
+// slots, then the most expensive sample.
+template <size_t N>
+constexpr size_t NextToPlace(const SensorDescriptor *sensors,
+                             const size_t count, const bool (&placed)[N]) {
+  size_t next = count;
+  for (size_t i = 0; i < count; ++i) {
+    if (placed[i] || !IsPlanned(sensors[i])) {
+      continue;
+    }
+    if (next == count) {
+      next = i;
+      continue;
+    }
+    const SensorContext &candidate = *sensors[i].base;
+    const SensorContext &best = *sensors[next].base;
+    if (candidate.pollIntervalMs < best.pollIntervalMs ||
+        (candidate.pollIntervalMs == best.pollIntervalMs &&
+         candidate.sampleCostUs > best.sampleCostUs)) {
+      next = i;
+    }
+  }
+  return next;
+}
+
+}  // namespace phase_plan_detail
+
+// Builds the phase plan for the first `count` entries of `sensors`. N is the
+// storage size and must be at least 1 and at least `count`. Sensors that are
+// disabled (no context or a zero interval) or event-driven get an offset of
+// zero.
+template <size_t N>
+constexpr SensorPhasePlan<N> PlanSensorPhases(const SensorDescriptor *sensors,
+                                              const size_t count) {
+  SensorPhasePlan<N> plan{};
+  uint8_t frames[kPhasePlanMaxWindowMs] = {};
+  uint32_t cost[kPhasePlanMaxWindowMs] = {};
+  bool placed[N] = {};
+
+  plan.windowMs = phase_plan_detail::PlanWindowMs(sensors, count);
+  for (size_t step = 0; step < count; ++step) {
+    const size_t next = phase_plan_detail::NextToPlace(sensors, count, placed);
+    if (next == count) {
+      break;
+    }
+    placed[next] = true;
+
+    const uint16_t interval = sensors[next].base->pollIntervalMs;
+    const uint16_t sampleCost = sensors[next].base->sampleCostUs;
+    uint16_t bestOffset = 0;
+    uint8_t bestFrames = UINT8_MAX;
+    uint32_t bestCost = UINT32_MAX;
+    for (uint16_t offset = 0; offset < interval && offset < plan.windowMs;
+         ++offset) {
+      uint8_t peakFrames = plan.peakFramesPerMs;
+      uint32_t peakCost = plan.peakCostUsPerMs;
+      for (uint32_t tick = offset; tick < plan.windowMs; tick += interval) {
+        if (frames[tick] + 1U > peakFrames) {
+          peakFrames = static_cast<uint8_t>(frames[tick] + 1U);
+        }
+        if (cost[tick] + sampleCost > peakCost) {
+          peakCost = cost[tick] + sampleCost;
+        }
+      }
+      if (peakFrames < bestFrames ||
+          (peakFrames == bestFrames && peakCost < bestCost)) {
+        bestOffset = offset;
+        bestFrames = peakFrames;
+        bestCost = peakCost;
+      }
+    }
+
+    for (uint32_t tick = bestOffset; tick < plan.windowMs; tick += interval) {
+      ++frames[tick];
+      cost[tick] += sampleCost;
+    }
+    plan.offsetMs[next] = bestOffset;
+    plan.peakFramesPerMs = bestFrames;
+    plan.peakCostUsPerMs = bestCost;
+  }
+  return plan;
+}
+
+#if BAJACAN_REPORT_PHASE_PLAN
+// Instantiating this emits a deprecation warning whose text carries the plan's
+// figures, which is the only way to print a constexpr value to the build log.
+template <unsigned kPeakFramesPerMs, unsigned long kPeakCostUsPerMs,
+          unsigned kWindowMs>
+[[deprecated("sensor phase plan report (informational, see template values)")]]
+constexpr bool ReportPhasePlan() {
+  return true;
+}
+#endif
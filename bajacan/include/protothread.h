@@ -0,0 +1,70 @@
+// Stackless coroutines (protothreads) for multi-step sensor drivers. A
+// protothread is an ordinary function that is called repeatedly; the macros
+// below turn it into a state machine that resumes where it last waited, so a
+// driver can wait for a delay, a pin or a bus transfer without blocking
+// loop() or needing a stack of its own. State is one Protothread per task.
+//
+// Drive one from a two-phase sensor's collect: the wait macros return a
+// value-initialized result, which for SensorCollectResult is Pending, so the
+// main loop calls collect again on its next pass. Reset the task in
+// startConversion.
+//
+// Rules, as with any switch-based protothread: locals do not survive a wait
+// (keep them in the driver's state), and the body must not contain its own
+// switch statement. No Arduino dependency, so drivers can be run on a host.
+
+#pragma once
+
+#include <stdint.h>
+
+struct Protothread {
+  uint16_t resumeLine;  // 0: start of the body.
+  uint32_t markMs;      // Start of the current PT_WAIT_MS.
+};
+
+inline void ProtothreadReset(Protothread &pt) { pt.resumeLine = 0; }
+
+#define PT_BEGIN(pt)         \
+  switch ((pt).resumeLine) { \
+    case 0:
+
+// Resets the task and returns `result`; place it last in the function.
+#define PT_END(pt, result) \
+  }                        \
+  (pt).resumeLine = 0;     \
+  return result
+
+// Returns `result` now; the next call starts over.
+#define PT_EXIT(pt, result) \
+  do {                      \
+    (pt).resumeLine = 0;    \
+    return result;          \
+  } while (0)
+
+// Returns until `condition` holds; it is re-evaluated on every call.
+#define PT_WAIT_UNTIL(pt, condition) \
+  do {                               \
+    (pt).resumeLine = __LINE__;      \
+    [[fallthrough]];                 \
+    case __LINE__:                   \
+      if (!(condition)) {            \
+        return {};                   \
+      }                              \
+  } while (0)
+
+// Returns once, resuming after this point on the next call.
+#define PT_YIELD(pt)            \
+  do {                          \
+    (pt).resumeLine = __LINE__; \
+    return {};                  \
+    case __LINE__:;             \
+  } while (0)
+
+// `nowMs` is re-evaluated on every call, so pass millis() or the loop's
+// current timestamp, not a value captured before the wait.
+#define PT_WAIT_MS(pt, nowMs, ms)                                    \
+  do {                                                               \
+    (pt).markMs = (nowMs);                                           \
+    PT_WAIT_UNTIL(                                                   \
+        (pt), static_cast<uint32_t>((nowMs) - (pt).markMs) >= (ms)); \
+  } while (0)
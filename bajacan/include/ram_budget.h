@@ -0,0 +1,63 @@
+// Compile-time memory budget for a board. main.cpp checks the MCP251863's
+// message RAM and the AVR heap claimed by the CAN driver's FIFOs with
+// static_assert, so an over-committed board fails to build instead of failing
+// ACAN2517FD::begin() (kControllerRamUsageGreaterThan2048) or running the heap
+// into the stack on the node. Only the driver FIFOs are counted: they come
+// from the heap, so the linker's RAM report never shows them. Globals (sensor
+// state, the core's tables, diagnostics) are in .data/.bss, which
+// `pio run -t size` reports.
+
+#pragma once
+
+#include <config.h>
+#include <stdint.h>
+
+constexpr uint16_t kMcpMessageRamBytes = 2048;
+
+// Heap the CAN driver FIFOs may claim: half of the AVR128DB's 16 KB, leaving
+// the other half for .data/.bss and the stack. Override with
+// -DBAJACAN_CAN_FIFO_RAM_BUDGET=<bytes> on boards with more or fewer globals.
+#ifndef BAJACAN_CAN_FIFO_RAM_BUDGET
+#define BAJACAN_CAN_FIFO_RAM_BUDGET 8192
+#endif
+
+// Message object size in controller RAM: 8 header bytes plus the payload.
+constexpr uint16_t CanObjectBytes(
+    const ACAN2517FDSettings::PayloadSize payload) {
+  return ACAN2517FDSettings::objectSizeForPayload(payload);
+}
+
+constexpr uint32_t McpRamUsage(const CanBufferConfig &buffers) {
+  return static_cast<uint32_t>(buffers.controllerTxqSize) *
+             CanObjectBytes(buffers.controllerTxqPayload) +
+         static_cast<uint32_t>(buffers.controllerReceiveFifoSize) *
+             CanObjectBytes(buffers.controllerReceiveFifoPayload) +
+         static_cast<uint32_t>(buffers.controllerTransmitFifoSize) *
+             CanObjectBytes(buffers.controllerTransmitFifoPayload);
+}
+
+constexpr uint32_t CanDriverRamUsage(const CanBufferConfig &buffers) {
+  return (static_cast<uint32_t>(buffers.driverTransmitFifoSize) +
+          buffers.driverReceiveFifoSize) *
+         sizeof(CANFDMessage);
+}
+
+constexpr bool CanBuffersValid(const CanBufferConfig &buffers) {
+  return buffers.controllerTransmitFifoSize >= 1U &&
+         buffers.controllerTransmitFifoSize <= 32U &&
+         buffers.controllerTxqSize <= 32U &&
+         buffers.controllerReceiveFifoSize >= 1U &&
+         buffers.controllerReceiveFifoSize <= 32U &&
+         buffers.driverReceiveFifoSize >= 1U;
+}
+
+#if BAJACAN_REPORT_RAM_BUDGET
+// Emits a compiler warning whose template arguments show the budget, e.g.
+// "ReportRamBudget<2016, 3456, 8192>".
+template <unsigned long kMcpBytes, unsigned long kDriverBytes,
+          unsigned long kDriverBudget>
+[[deprecated("RAM budget report (informational, see template values)")]]
+constexpr bool ReportRamBudget() {
+  return true;
+}
+#endif
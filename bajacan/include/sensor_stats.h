@@ -0,0 +1,94 @@
+// Optional per-sensor timing instrumentation for PollSensors. Enable with
+// -DBAJACAN_ENABLE_SENSOR_STATS=1; when disabled main.cpp compiles the hooks
+// out entirely.
+//
+// A frame on kBoardConfig.diagnostics.requestId whose first byte is a
+// SensorStatsCommand makes the node answer with one 64-byte frame per sensor on
+// diagnostics.responseId. Multi-byte fields are big-endian:
+//   [0] sensor index          [1] sensor count
+//   [2..5]   polls            [6..11]  lateness min/max/mean (ms)
+//   [12..17] sample min/max/mean (us)
+//   [18..21] TX ok            [22..25] TX failed    [26..29] sample skipped
+//   [30..45] lateness histogram, 8 x u16 (0, 1, 2-3, 4-7, ... 64+ ms)
+//   [46..61] sample histogram, 8 x u16 (0-7, 8-15, 16-31, ... 512+ us)
+//   [62..63] frames suppressed by the deadband (saturating u16)
+
+#pragma once
+
+#include <ACAN2517FD.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef BAJACAN_ENABLE_SENSOR_STATS
+#define BAJACAN_ENABLE_SENSOR_STATS 0
+#endif
+
+enum class SensorTxOutcome : uint8_t {
+  Sent,        // tryToSend accepted the frame.
+  Failed,      // tryToSend rejected the frame.
+  Skipped,     // sample() returned false; nothing was sent.
+  Suppressed,  // Value stayed inside the deadband; nothing was sent.
+};
+
+enum SensorStatsCommand : uint8_t {
+  kSensorStatsDump = 0x01,
+  kSensorStatsDumpAndReset = 0x02,
+};
+
+constexpr uint8_t kSensorStatsHistogramBuckets = 8;
+
+struct SensorTimingStat {
+  uint32_t min;
+  uint32_t max;
+  uint32_t sum;
+  uint16_t histogram[kSensorStatsHistogramBuckets];
+};
+
+struct SensorStats {
+  uint32_t polls;
+  SensorTimingStat latenessMs;
+  SensorTimingStat sampleUs;
+  uint32_t txOk;
+  uint32_t txFailed;
+  uint32_t skipped;
+  uint16_t suppressed;
+};
+
+#if BAJACAN_ENABLE_SENSOR_STATS
+// `stats` is main.cpp's table, one entry per board sensor; reports go out on
+// responseId.
+void SensorStatsBegin(SensorStats *stats, size_t count, uint32_t responseId,
+                      bool useExtendedIds);
+void SensorStatsReset();
+void SensorStatsRecordPoll(size_t index, uint32_t latenessMs, uint32_t sampleUs);
+void SensorStatsRecordTx(size_t index, SensorTxOutcome outcome);
+// Fills outFrame with the report for one sensor; returns false past the end.
+bool SensorStatsBuildFrame(size_t index, CANFDMessage &outFrame);
+#else
+inline void SensorStatsBegin(SensorStats *stats, const size_t count,
+                             const uint32_t responseId,
+                             const bool useExtendedIds) {
+  (void)stats;
+  (void)count;
+  (void)responseId;
+  (void)useExtendedIds;
+}
+inline void SensorStatsReset() {}
+inline void SensorStatsRecordPoll(const size_t index,
+                                  const uint32_t latenessMs,
+                                  const uint32_t sampleUs) {
+  (void)index;
+  (void)latenessMs;
+  (void)sampleUs;
+}
+inline void SensorStatsRecordTx(const size_t index,
+                                const SensorTxOutcome outcome) {
+  (void)index;
+  (void)outcome;
+}
+inline bool SensorStatsBuildFrame(const size_t index, CANFDMessage &outFrame) {
+  (void)index;
+  (void)outFrame;
+  return false;
+}
+#endif
@@ -62,6 +62,15 @@ class ACAN2517FD {
   public: static const uint32_t kISRNotNullAndNoIntPin              = uint32_t (1) << 19 ;
   public: static const uint32_t kInvalidTDCO                        = uint32_t (1) << 20 ;
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  //   Wait until the mode requested by begin is reached (returns 0 if ok,
+  //   kRequestedModeTimeOut otherwise). begin calls it itself unless
+  //   ACAN2517FDSettings::mWaitForRequestedMode is false, which lets the caller
+  //   do other work while the controller integrates to the bus.
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  public: uint32_t waitForRequestedMode (const uint32_t inTimeOutMillis = 10) ;
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //   end method (resets the MCP2517FD, deallocate buffers, and detach interrupt pin)
   //   Return true if end method succeeds, and false otherwise
@@ -75,6 +84,13 @@ class ACAN2517FD {
 
   public: bool tryToSend (const CANFDMessage & inMessage) ;
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  //   Send several messages in order within one SPI transaction; stops at the
+  //   first message that cannot be sent. Returns the number of messages sent.
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  public: uint8_t tryToSendBatch (const CANFDMessage inMessages [], const uint8_t inCount) ;
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //    Receive a message
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -202,6 +218,7 @@ class ACAN2517FD {
   private: uint16_t readRegister16 (const uint16_t inAddress) ;
   private: uint32_t readRegister32 (const uint16_t inAddress) ;
 
+  private: bool sendAssume_SPI_transaction (const CANFDMessage & inMessage) ;
   private: bool sendViaTXQ (const CANFDMessage & inMessage) ;
   private: bool enterInTransmitBuffer (const CANFDMessage & inMessage) ;
   private: void appendInControllerTxFIFO (const CANFDMessage & inMessage) ;
@@ -85,19 +85,19 @@ class ACAN2517FDSettings {
   //   CONSTRUCTOR
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  public: ACAN2517FDSettings (const Oscillator inOscillator,
-                              const uint32_t inDesiredArbitrationBitRate,
-                              const DataBitRateFactor inDataBitRateFactor,
-                              const uint32_t inTolerancePPM = 1000) ;
+  public: constexpr ACAN2517FDSettings (const Oscillator inOscillator,
+                                        const uint32_t inDesiredArbitrationBitRate,
+                                        const DataBitRateFactor inDataBitRateFactor,
+                                        const uint32_t inTolerancePPM = 1000) ;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //   DEPRECATED CONSTRUCTOR (for compatibility with version < 2.1.0)
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  public: ACAN2517FDSettings (const Oscillator inOscillator,
-                              const uint32_t inDesiredArbitrationBitRate,
-                              const DataBitRateFactor_Deprecated inDataBitRateFactor,
-                              const uint32_t inTolerancePPM = 1000) :
+  public: constexpr ACAN2517FDSettings (const Oscillator inOscillator,
+                                        const uint32_t inDesiredArbitrationBitRate,
+                                        const DataBitRateFactor_Deprecated inDataBitRateFactor,
+                                        const uint32_t inTolerancePPM = 1000) :
   ACAN2517FDSettings (inOscillator, inDesiredArbitrationBitRate, DataBitRateFactor (inDataBitRateFactor), inTolerancePPM) {
   }
 
@@ -155,6 +155,18 @@ class ACAN2517FDSettings {
 
   public: OperationMode mRequestedMode = NormalFD ;
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  //    Fast boot
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+//--- true --> begin skips the SPI read-back tests at 800 kHz and at full speed;
+//    only safe when the MCP2517FD stayed powered and already passed them
+  public: bool mSkipSPIReadBackTests = false ;
+
+//--- false --> begin returns right after requesting mRequestedMode, the caller
+//    must then call ACAN2517FD::waitForRequestedMode before sending
+  public: bool mWaitForRequestedMode = true ;
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //   TRANSMIT FIFO
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -208,19 +220,19 @@ class ACAN2517FDSettings {
   //    SYSCLOCK frequency computation
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  public: static uint32_t sysClock (const Oscillator inOscillator) ;
+  public: static constexpr uint32_t sysClock (const Oscillator inOscillator) ;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //    Accessors
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  public: Oscillator oscillator (void) const { return mOscillator ; }
-  public: uint32_t sysClock (void) const { return mSysClock ; }
-  public: uint32_t actualArbitrationBitRate (void) const ;
-  public: uint32_t actualDataBitRate (void) const ;
-  public: bool exactArbitrationBitRate (void) const ;
-  public: bool exactDataBitRate (void) const ;
-  public: bool dataBitRateIsAMultipleOfArbitrationBitRate (void) const ;
+  public: constexpr Oscillator oscillator (void) const { return mOscillator ; }
+  public: constexpr uint32_t sysClock (void) const { return mSysClock ; }
+  public: constexpr uint32_t actualArbitrationBitRate (void) const ;
+  public: constexpr uint32_t actualDataBitRate (void) const ;
+  public: constexpr bool exactArbitrationBitRate (void) const ;
+  public: constexpr bool exactDataBitRate (void) const ;
+  public: constexpr bool dataBitRateIsAMultipleOfArbitrationBitRate (void) const ;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //    RAM USAGE
@@ -228,27 +240,27 @@ class ACAN2517FDSettings {
 
   public: uint32_t ramUsage (void) const ;
 
-  public: static uint32_t objectSizeForPayload (const PayloadSize inPayload) ;
+  public: static constexpr uint32_t objectSizeForPayload (const PayloadSize inPayload) ;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //    Distance between actual bit rate and requested bit rate (in ppm, part-per-million)
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  public: uint32_t ppmFromDesiredArbitrationBitRate (void) const ;
-  public: uint32_t ppmFromDesiredDataBitRate (void) const ;
+  public: constexpr uint32_t ppmFromDesiredArbitrationBitRate (void) const ;
+  public: constexpr uint32_t ppmFromDesiredDataBitRate (void) const ;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //    Distance of sample point from bit start (in ppc, part-per-cent, denoted by %)
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  public: uint32_t arbitrationSamplePointFromBitStart (void) const ;
-  public: uint32_t dataSamplePointFromBitStart (void) const ;
+  public: constexpr uint32_t arbitrationSamplePointFromBitStart (void) const ;
+  public: constexpr uint32_t dataSamplePointFromBitStart (void) const ;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //    Bit settings are consistent ? (returns 0 if ok)
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  public: uint32_t CANBitSettingConsistency (void) const ;
+  public: constexpr uint32_t CANBitSettingConsistency (void) const ;
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   //    Constants returned by CANBitSettingConsistency
@@ -292,5 +304,301 @@ class ACAN2517FDSettings {
 
 } ;
 
+//------------------------------------------------------------------------------
+//   Inline definitions: constexpr, so that a constexpr ACAN2517FDSettings
+//   object gets its bit timing computed (and checkable with static_assert) at
+//   compile time
+//------------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wswitch-enum"
+
+//------------------------------------------------------------------------------
+//    sysClock
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::sysClock (const Oscillator inOscillator) {
+  uint32_t sysClock = 40UL * 1000 * 1000 ;
+  switch (inOscillator) {
+  case OSC_4MHz:
+    sysClock = 4UL * 1000 * 1000 ;
+    break ;
+  case OSC_4MHz_DIVIDED_BY_2:
+    sysClock = 2UL * 1000 * 1000 ;
+    break ;
+  case OSC_4MHz10xPLL_DIVIDED_BY_2 :
+  case OSC_40MHz_DIVIDED_BY_2:
+  case OSC_20MHz:
+    sysClock = 20UL * 1000 * 1000 ;
+    break ;
+  case OSC_20MHz_DIVIDED_BY_2:
+    sysClock = 10UL * 1000 * 1000 ;
+    break ;
+  case OSC_4MHz10xPLL:
+  case OSC_40MHz:
+    break ;
+  }
+  return sysClock ;
+}
+
+//------------------------------------------------------------------------------
+//   CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+constexpr ACAN2517FDSettings::ACAN2517FDSettings (const Oscillator inOscillator,
+                                                  const uint32_t inDesiredArbitrationBitRate,
+                                                  const DataBitRateFactor inDataBitRateFactor,
+                                                  const uint32_t inTolerancePPM) :
+mOscillator (inOscillator),
+mSysClock (sysClock (inOscillator)),
+mDesiredArbitrationBitRate (inDesiredArbitrationBitRate),
+mDataBitRateFactor (inDataBitRateFactor) {
+// First compute data bit rate
+  const uint32_t maxDataTQCount = MAX_DATA_PHASE_SEGMENT_1 + MAX_DATA_PHASE_SEGMENT_2 ; // Setting for slowest bit rate
+  const uint32_t desiredDataBitRate = inDesiredArbitrationBitRate * uint8_t (inDataBitRateFactor) ;
+  uint32_t smallestError = UINT32_MAX ;
+  uint32_t bestBRP = MAX_BRP ; // Setting for lowest bit rate
+  uint32_t bestDataTQCount = maxDataTQCount ; // Setting for lowest bit rate
+  uint32_t dataTQCount = 4 ;
+  uint32_t brp = mSysClock / desiredDataBitRate / dataTQCount ;
+//--- Loop for finding best BRP and best TQCount
+  while ((dataTQCount <= maxDataTQCount) && (brp > 0)) {
+  //--- Compute error using brp
+    if (brp <= MAX_BRP) {
+      const uint32_t error = mSysClock - desiredDataBitRate * dataTQCount * brp ; // error is always >= 0
+      if (error <= smallestError) {
+        smallestError = error ;
+        bestBRP = brp ;
+        bestDataTQCount = dataTQCount ;
+      }
+    }
+  //--- Compute error using brp+1
+    if (brp < MAX_BRP) {
+      const uint32_t error = desiredDataBitRate * dataTQCount * (brp + 1) - mSysClock ; // error is always >= 0
+      if (error <= smallestError) {
+        smallestError = error ;
+        bestBRP = brp + 1 ;
+        bestDataTQCount = dataTQCount ;
+      }
+    }
+  //--- Continue with next value of BRP
+    dataTQCount += 1 ;
+    brp = mSysClock / desiredDataBitRate / dataTQCount ;
+  }
+//--- Compute data PS2 (1 <= PS2 <= 16)
+  uint32_t dataPS2 = bestDataTQCount / 5 ; // For sampling point at 80%
+  if (dataPS2 == 0) {
+    dataPS2 = 1 ;
+  }
+//--- Compute data PS1 (1 <= PS1 <= 32)
+  uint32_t dataPS1 = bestDataTQCount - dataPS2 - 1 /* Sync Seg */ ;
+  if (dataPS1 > MAX_DATA_PHASE_SEGMENT_1) {
+    dataPS2 += dataPS1 - MAX_DATA_PHASE_SEGMENT_1 ;
+    dataPS1 = MAX_DATA_PHASE_SEGMENT_1 ;
+  }
+//---
+  if ((mDesiredArbitrationBitRate * uint32_t (inDataBitRateFactor)) <= (1000UL * 1000)) {
+    mTDCO = 0 ;
+  }else{
+    const int TDCO = bestBRP * dataPS1 ; // According to DS20005678D, §3.4.8 Page 20
+    mTDCO = (TDCO > 63) ? 63 : (int8_t) TDCO ;
+  }
+  mDataPhaseSegment1 = (uint8_t) dataPS1 ;
+  mDataPhaseSegment2 = (uint8_t) dataPS2 ;
+  mDataSJW = mDataPhaseSegment2 ;
+  const uint32_t arbitrationTQCount = bestDataTQCount * uint8_t (mDataBitRateFactor) ;
+//--- Compute arbitration PS2 (1 <= PS2 <= 128)
+  uint32_t arbitrationPS2 = arbitrationTQCount / 5 ; // For sampling point at 80%
+  if (arbitrationPS2 == 0) {
+    arbitrationPS2 = 1 ;
+  }
+//--- Compute PS1 (1 <= PS1 <= 256)
+  uint32_t arbitrationPS1 = arbitrationTQCount - arbitrationPS2 - 1 /* Sync Seg */ ;
+  if (arbitrationPS1 > MAX_ARBITRATION_PHASE_SEGMENT_1) {
+    arbitrationPS2 += arbitrationPS1 - MAX_ARBITRATION_PHASE_SEGMENT_1 ;
+    arbitrationPS1 = MAX_ARBITRATION_PHASE_SEGMENT_1 ;
+  }
+//---
+  mBitRatePrescaler = (uint16_t) bestBRP ;
+  mArbitrationPhaseSegment1 = (uint16_t) arbitrationPS1 ;
+  mArbitrationPhaseSegment2 = (uint8_t) arbitrationPS2 ;
+  mArbitrationSJW = mArbitrationPhaseSegment2 ; // Always 1 <= SJW <= 128, and SJW <= mArbitrationPhaseSegment2
+//--- Final check of the nominal configuration
+  const uint32_t W = arbitrationTQCount * mDesiredArbitrationBitRate * bestBRP ;
+  const uint64_t diff = (mSysClock > W) ? (mSysClock - W) : (W - mSysClock) ;
+  const uint64_t ppm = (uint64_t) (1000UL * 1000UL) ; // UL suffix is required for Arduino Uno
+  mArbitrationBitRateClosedToDesiredRate = (diff * ppm) <= (((uint64_t) W) * inTolerancePPM) ;
+}
+
+//------------------------------------------------------------------------------
+//   ACCESSORS
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::actualArbitrationBitRate (void) const {
+  const uint32_t arbitrationTQCount = 1 /* Sync Seg */ + mArbitrationPhaseSegment1 + mArbitrationPhaseSegment2 ;
+  return mSysClock / mBitRatePrescaler / arbitrationTQCount ;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::actualDataBitRate (void) const {
+  if (mDataBitRateFactor == DataBitRateFactor::x1) {
+    return actualArbitrationBitRate () ;
+  }else{
+    const uint32_t dataTQCount = 1 /* Sync Seg */ + mDataPhaseSegment1 + mDataPhaseSegment2 ;
+    return mSysClock / mBitRatePrescaler / dataTQCount ;
+  }
+}
+
 //------------------------------------------------------------------------------
 
+constexpr bool ACAN2517FDSettings::exactArbitrationBitRate (void) const {
+  const uint32_t TQCount = 1 /* Sync Seg */ + mArbitrationPhaseSegment1 + mArbitrationPhaseSegment2 ;
+  return mSysClock == (mBitRatePrescaler * mDesiredArbitrationBitRate * TQCount) ;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr bool ACAN2517FDSettings::exactDataBitRate (void) const {
+  if (mDataBitRateFactor == DataBitRateFactor::x1) {
+    return exactArbitrationBitRate () ;
+  }else{
+    const uint32_t TQCount = 1 /* Sync Seg */ + mDataPhaseSegment1 + mDataPhaseSegment2 ;
+    return mSysClock == (mBitRatePrescaler * mDesiredArbitrationBitRate * TQCount * uint8_t (mDataBitRateFactor)) ;
+  }
+}
+
+//------------------------------------------------------------------------------
+
+constexpr bool ACAN2517FDSettings::dataBitRateIsAMultipleOfArbitrationBitRate (void) const {
+  bool result = mDataBitRateFactor == DataBitRateFactor::x1 ;
+  if (!result) {
+    const uint32_t dataTQCount = 1 /* Sync Seg */ + mDataPhaseSegment1 + mDataPhaseSegment2 ;
+    const uint32_t arbitrationTQCount = 1 /* Sync Seg */ + mArbitrationPhaseSegment1 + mArbitrationPhaseSegment2 ;
+    result = arbitrationTQCount == (dataTQCount * uint8_t (mDataBitRateFactor)) ;
+  }
+  return result ;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::ppmFromDesiredArbitrationBitRate (void) const {
+  const uint32_t TQCount = 1 /* Sync Seg */ + mArbitrationPhaseSegment1 + mArbitrationPhaseSegment2 ;
+  const uint32_t W = TQCount * mDesiredArbitrationBitRate * mBitRatePrescaler ;
+  const uint64_t diff = (mSysClock > W) ? (mSysClock - W) : (W - mSysClock) ;
+  const uint64_t ppm = (uint64_t) (1000UL * 1000UL) ; // UL suffix is required for Arduino Uno
+  return (uint32_t) ((diff * ppm) / W) ;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::ppmFromDesiredDataBitRate (void) const {
+  if (mDataBitRateFactor == DataBitRateFactor::x1) {
+    return ppmFromDesiredArbitrationBitRate () ;
+  }else{
+    const uint32_t TQCount = 1 /* Sync Seg */ + mDataPhaseSegment1 + mDataPhaseSegment2 ;
+    const uint32_t W = TQCount * mDesiredArbitrationBitRate * uint8_t (mDataBitRateFactor) * mBitRatePrescaler ;
+    const uint64_t diff = (mSysClock > W) ? (mSysClock - W) : (W - mSysClock) ;
+    const uint64_t ppm = (uint64_t) (1000UL * 1000UL) ; // UL suffix is required for Arduino Uno
+    return (uint32_t) ((diff * ppm) / W) ;
+  }
+}
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::arbitrationSamplePointFromBitStart (void) const {
+  const uint32_t nominalTQCount = 1 /* Sync Seg */ + mArbitrationPhaseSegment1 + mArbitrationPhaseSegment2 ;
+  const uint32_t samplePoint = 1 /* Sync Seg */ + mArbitrationPhaseSegment1 ;
+  const uint32_t partPerCent = 100 ;
+  return (samplePoint * partPerCent) / nominalTQCount ;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::dataSamplePointFromBitStart (void) const {
+  const uint32_t nominalTQCount = 1 /* Sync Seg */ + mDataPhaseSegment1 + mDataPhaseSegment2 ;
+  const uint32_t samplePoint = 1 /* Sync Seg */ + mDataPhaseSegment1 ;
+  const uint32_t partPerCent = 100 ;
+  return (samplePoint * partPerCent) / nominalTQCount ;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::CANBitSettingConsistency (void) const {
+  uint32_t errorCode = 0 ; // Means no error
+//--- Bit rate prescaler
+  if (mBitRatePrescaler == 0) {
+    errorCode |= kBitRatePrescalerIsZero ;
+  }else if (mBitRatePrescaler > MAX_BRP) {
+    errorCode |= kBitRatePrescalerIsGreaterThan256 ;
+  }
+//--- Arbitration Phase Segment 1
+  if (mArbitrationPhaseSegment1 < 2) {
+    errorCode |= kArbitrationPhaseSegment1IsLowerThan2 ;
+  }else if (mArbitrationPhaseSegment1 > MAX_ARBITRATION_PHASE_SEGMENT_1) {
+    errorCode |= kArbitrationPhaseSegment1IsGreaterThan256 ;
+  }
+//--- Arbitration Phase Segment 2
+  if (mArbitrationPhaseSegment2 == 0) {
+    errorCode |= kArbitrationPhaseSegment2IsZero ;
+  }else if (mArbitrationPhaseSegment2 > MAX_ARBITRATION_PHASE_SEGMENT_2) {
+    errorCode |= kArbitrationPhaseSegment2IsGreaterThan128 ;
+  }
+//--- Arbitration SJW
+  if (mArbitrationSJW == 0) {
+    errorCode |= kArbitrationSJWIsZero ;
+  }else if (mArbitrationSJW > MAX_ARBITRATION_SJW) {
+    errorCode |= kArbitrationSJWIsGreaterThan128 ;
+  }
+  if (mArbitrationSJW > mArbitrationPhaseSegment1) {
+    errorCode |= kArbitrationSJWIsGreaterThanPhaseSegment1 ;
+  }
+  if (mArbitrationSJW > mArbitrationPhaseSegment2) {
+    errorCode |= kArbitrationSJWIsGreaterThanPhaseSegment2 ;
+  }
+//--- Data bit rate ?
+  if (mDataBitRateFactor != DataBitRateFactor::x1) {
+    if (! dataBitRateIsAMultipleOfArbitrationBitRate ()) {
+      errorCode |= kArbitrationTQCountNotDivisibleByDataBitRateFactor ;
+    }
+  //--- Data Phase Segment 1
+    if (mDataPhaseSegment1 < 2) {
+      errorCode |= kDataPhaseSegment1IsLowerThan2 ;
+    }else if (mDataPhaseSegment1 > MAX_DATA_PHASE_SEGMENT_1) {
+      errorCode |= kDataPhaseSegment1IsGreaterThan32 ;
+    }
+  //--- Data Phase Segment 2
+    if (mDataPhaseSegment2 == 0) {
+      errorCode |= kDataPhaseSegment2IsZero ;
+    }else if (mDataPhaseSegment2 > MAX_DATA_PHASE_SEGMENT_2) {
+      errorCode |= kDataPhaseSegment2IsGreaterThan16 ;
+    }
+  //--- Data SJW
+    if (mDataSJW == 0) {
+      errorCode |= kDataSJWIsZero ;
+    }else if (mDataSJW > MAX_DATA_SJW) {
+      errorCode |= kDataSJWIsGreaterThan16 ;
+    }
+    if (mDataSJW > mDataPhaseSegment1) {
+      errorCode |= kDataSJWIsGreaterThanPhaseSegment1 ;
+    }
+    if (mDataSJW > mDataPhaseSegment2) {
+      errorCode |= kDataSJWIsGreaterThanPhaseSegment2 ;
+    }
+  }
+//---
+  return errorCode ;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ACAN2517FDSettings::objectSizeForPayload (const PayloadSize inPayload) {
+  const uint8_t kPayload [8] = {16, 20, 24, 28, 32, 40, 56, 72} ;
+  return kPayload [inPayload] ;
+}
+
+//------------------------------------------------------------------------------
+
+#pragma GCC diagnostic pop
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,165 @@
+// Raw-count to engineering-unit conversion for analog sensors. Everything is
+// built at compile time; sample() only does a multiply and shift (linear) or
+// one table lookup and interpolation (piecewise), with no division.
+//
+// Calibrated frames carry a signed 16-bit value in whatever unit the
+// calibration was built for (e.g. mV, 0.1 degC, 0.1 kPa), clamped to int16.
+
+#pragma once
+
+#include <constexpr_math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct AnalogCalibration {
+  // Piecewise-linear form: table[i] is the value at raw = i << tableShift and
+  // raw readings past the last entry clamp to it. nullptr selects the linear
+  // form below.
+  const int16_t *table;
+  uint8_t tableShift;
+  uint8_t tableSegments;
+  // Linear form: value = offset + (raw * multiplier) >> shift.
+  int16_t multiplier;
+  uint8_t shift;
+  int16_t offset;
+};
+
+// Measured (raw, value) pair for TableFromPoints.
+struct CalibrationPoint {
+  double raw;
+  double value;
+};
+
+// Uniformly spaced table of 2^kSegmentsLog2 segments; keep it constexpr at
+// namespace scope and point a TableCalibration at it.
+template <uint8_t kSegmentsLog2>
+struct CalibrationTable {
+  static_assert(kSegmentsLog2 >= 1U && kSegmentsLog2 <= 7U,
+                "Calibration tables hold 2 to 128 segments");
+  static constexpr uint16_t kSegments = 1U << kSegmentsLog2;
+  int16_t values[kSegments + 1];
+};
+
+namespace analog_calibration_detail {
+constexpr int16_t ClampToInt16(const double value) {
+  return value >= INT16_MAX
+             ? INT16_MAX
+             : (value <= INT16_MIN ? INT16_MIN
+                                   : static_cast<int16_t>(CxRound(value)));
+}
+
+// Raw value at table entry `i` for a reading of `inputBits` bits.
+constexpr double EntryRaw(const uint16_t i, const uint8_t segmentsLog2,
+                          const uint8_t inputBits) {
+  return static_cast<double>(static_cast<uint32_t>(i)
+                             << (inputBits - segmentsLog2));
+}
+}  // namespace analog_calibration_detail
+
+// value = offset + raw * unitsPerCount. The multiplier is scaled up as far as
+// 15 bits allow, which keeps raw * multiplier plus rounding inside int32 for
+// any 16-bit reading.
+constexpr AnalogCalibration LinearCalibration(const double offset,
+                                              const double unitsPerCount) {
+  uint8_t shift = 0;
+  while (shift < 24 &&
+         CxAbs(unitsPerCount * (1L << (shift + 1))) <= INT16_MAX / 2) {
+    ++shift;
+  }
+  return AnalogCalibration{
+      nullptr,
+      0,
+      0,
+      static_cast<int16_t>(CxRound(unitsPerCount * (1L << shift))),
+      shift,
+      analog_calibration_detail::ClampToInt16(offset),
+  };
+}
+
+template <uint8_t kSegmentsLog2>
+constexpr AnalogCalibration TableCalibration(
+    const CalibrationTable<kSegmentsLog2> &table, const uint8_t inputBits) {
+  return AnalogCalibration{
+      table.values,
+      static_cast<uint8_t>(inputBits - kSegmentsLog2),
+      static_cast<uint8_t>(CalibrationTable<kSegmentsLog2>::kSegments),
+      0,
+      0,
+      0,
+  };
+}
+
+// Resamples measured points (ascending raw, at least two) onto a uniform
+// table, interpolating between points and extrapolating the end segments.
+template <uint8_t kSegmentsLog2, size_t M>
+constexpr CalibrationTable<kSegmentsLog2> TableFromPoints(
+    const CalibrationPoint (&points)[M], const uint8_t inputBits) {
+  static_assert(M >= 2, "A calibration table needs at least two points");
+  CalibrationTable<kSegmentsLog2> table{};
+  for (uint16_t i = 0; i <= table.kSegments; ++i) {
+    const double raw =
+        analog_calibration_detail::EntryRaw(i, kSegmentsLog2, inputBits);
+    size_t upper = 1;
+    while (upper < M - 1 && points[upper].raw < raw) {
+      ++upper;
+    }
+    const CalibrationPoint &a = points[upper - 1];
+    const CalibrationPoint &b = points[upper];
+    const double value =
+        a.value + (raw - a.raw) * (b.value - a.value) / (b.raw - a.raw);
+    table.values[i] = analog_calibration_detail::ClampToInt16(value);
+  }
+  return table;
+}
+
+// NTC thermistor to ground with seriesOhms to the ADC reference, read as a
+// divider. Values are degC * unitsPerDegC from the beta equation; the end
+// entries use half a count instead of 0 / full scale to stay finite.
+template <uint8_t kSegmentsLog2>
+constexpr CalibrationTable<kSegmentsLog2> ThermistorTable(
+    const double beta, const double nominalOhms, const double nominalDegC,
+    const double seriesOhms, const uint8_t inputBits,
+    const double unitsPerDegC) {
+  CalibrationTable<kSegmentsLog2> table{};
+  const double fullScale = static_cast<double>(1UL << inputBits);
+  for (uint16_t i = 0; i <= table.kSegments; ++i) {
+    double raw =
+        analog_calibration_detail::EntryRaw(i, kSegmentsLog2, inputBits);
+    raw = raw < 0.5 ? 0.5 : (raw > fullScale - 0.5 ? fullScale - 0.5 : raw);
+    const double ratio = raw / fullScale;
+    const double ohms = seriesOhms * ratio / (1 - ratio);
+    const double kelvin =
+        1 / (1 / (nominalDegC + 273.15) + CxLog(ohms / nominalOhms) / beta);
+    table.values[i] = analog_calibration_detail::ClampToInt16(
+        (kelvin - 273.15) * unitsPerDegC);
+  }
+  return table;
+}
+
+// `raw` is signed for differential readings; tables clamp negative readings
+// to their first entry.
+inline int16_t ApplyCalibration(const AnalogCalibration &cal,
+                                const int32_t raw) {
+  if (cal.table == nullptr) {
+    int32_t product = raw * cal.multiplier;
+    if (cal.shift > 0U) {
+      product += 1L << (cal.shift - 1U);
+    }
+    const int32_t value = cal.offset + (product >> cal.shift);
+    return value > INT16_MAX ? INT16_MAX
+                             : (value < INT16_MIN ? INT16_MIN
+                                                  : static_cast<int16_t>(value));
+  }
+  if (raw < 0) {
+    return cal.table[0];
+  }
+  const uint16_t index = raw >> cal.tableShift;
+  if (index >= cal.tableSegments) {
+    return cal.table[cal.tableSegments];
+  }
+  const uint16_t fraction = raw & ((1UL << cal.tableShift) - 1U);
+  const int16_t low = cal.table[index];
+  const int16_t high = cal.table[index + 1];
+  return static_cast<int16_t>(
+      low + (((static_cast<int32_t>(high) - low) * fraction) >> cal.tableShift));
+}
@@ -1,21 +1,196 @@
 #pragma once
 
+#include <analog_calibration.h>
 #include <config.h>
 
+// ADC0 converts at 12 bits; its RES register is 16 bits wide.
+constexpr uint8_t kAnalogAdcBits = 12;
+constexpr uint8_t kAnalogMaxAccumulateLog2 = 7;  // 128 samples.
+constexpr uint8_t kAnalogMaxScanChannels = 8;
+// One conversion with DxCore's default ADC clock and sample length.
+constexpr uint16_t kAnalogConversionUs = 22;
+// Triggered mode clocks TCB0 at CLK_PER / 2, which overflows past this at
+// 24 MHz.
+constexpr uint16_t kAnalogMaxTriggerPeriodUs = 5000;
+// Time between Scan passes. Passes are started from TCB0 in periodic
+// interrupt mode, so the same CLK_PER / 2 limit applies.
+#ifndef BAJACAN_ANALOG_SCAN_PERIOD_US
+#define BAJACAN_ANALOG_SCAN_PERIOD_US 1000
+#endif
+static_assert(BAJACAN_ANALOG_SCAN_PERIOD_US > 0 &&
+                  BAJACAN_ANALOG_SCAN_PERIOD_US <= kAnalogMaxTriggerPeriodUs,
+              "BAJACAN_ANALOG_SCAN_PERIOD_US out of range for TCB0");
+// Samples carried by one Triggered frame: 4 header bytes + 30 x u16 = 64.
+constexpr uint8_t kAnalogTriggeredFrameSamples = 30;
+
+enum class AnalogReference : uint8_t {
+  Default,  // Leave VREF.ADC0REF as DxCore set it (analogReference()).
+  Vdd,
+  Internal1V024,
+  Internal2V048,
+  Internal2V500,
+  Internal4V096,
+  External,  // VREFA pin.
+};
+
+enum class AnalogMode : uint8_t {
+  // Convert inside sample() by programming ADC0 directly, spinning until the
+  // result is ready.
+  Blocking,
+  // Converted by the ADC0 scan interrupt. Every Scan sensor is one channel of
+  // a single pass that TCB0 starts every BAJACAN_ANALOG_SCAN_PERIOD_US;
+  // sample() returns the latest completed pass without waiting, and skips
+  // until the first pass has finished. The channel list is built from the
+  // board table at compile time (MakeAnalogScanTable) and handed to
+  // AnalogScanBegin() before the sensors begin. Owns TCB0 while any Scan
+  // sensor runs, so not combinable with Triggered or Windowed.
+  Scan,
+  // Conversions started in hardware every triggerPeriodUs: TCB0 drives EVSYS
+  // channel 0 into ADC0's start-conversion input, so sample instants carry no
+  // interrupt jitter. Results are queued by the ADC0 interrupt and sent up to
+  // kAnalogTriggeredFrameSamples at a time as
+  //   [0..1] sequence number of the first sample  [2] sample count
+  //   [3] flags (bit 0: samples were dropped before this frame)
+  //   [4..] samples, big-endian u16
+  // padded to a valid CAN FD length. The sensor signals data-ready once a
+  // full frame is queued, so pollIntervalMs only flushes partial frames.
+  // Owns ADC0, TCB0 and EVSYS channel 0; at most one per board and not
+  // combinable with other analog sensors.
+  Triggered,
+  // Samples like Triggered, but the ADC0 interrupt folds every result into
+  // running statistics instead of queueing it. Each poll closes the window
+  // (pollIntervalMs long) and sends
+  //   [0..1] min  [2..3] max  [4..5] mean  (int16, calibrated units)
+  //   [6..7] RMS (u16)        [8..9] samples in the window (u16)
+  // padded to 12 bytes, or skips if the window saw no samples. Same resource
+  // rules as Triggered.
+  Windowed,
+};
+
 struct AnalogSensorContext {
   SensorContext base;
-  uint8_t pin;
+  uint8_t pin;  // Positive input (MUXPOS).
+  // Differential mode measures pin - negativePin and sends signed readings
+  // (two's complement, 12 + extraBits bits) even when uncalibrated.
+  bool differential;
+  uint8_t negativePin;
+  // Reference for this sensor's conversions. Switching costs settling time, so
+  // keep one reference per board where possible; it is not restored after use.
+  // All Scan sensors must agree (Default matches any): AnalogScanBegin()
+  // rejects a table that mixes references.
+  AnalogReference reference;
+  // ADC0.SAMPCTRL sample length in ADC clocks (longer for high-impedance
+  // sources); 0 keeps DxCore's default.
+  uint8_t sampleLength;
+  AnalogMode mode;
+  // Hardware accumulation: ADC0 sums 2^accumulateLog2 back-to-back conversions
+  // per poll (0 = a single conversion). Raise sampleCostUs to match.
+  uint8_t accumulateLog2;
+  // Bits of resolution gained by decimating the sum; needs 4^extraBits
+  // samples, so at most accumulateLog2 / 2. The frame carries a
+  // (12 + extraBits)-bit value; with extraBits = 0 it is the plain average.
+  uint8_t extraBits;
+  // Triggered/Windowed only: time between hardware-started conversions.
+  uint16_t triggerPeriodUs;
+  // Optional conversion to engineering units (see analog_calibration.h),
+  // applied after decimation to every reading, Triggered samples included.
+  // nullptr sends raw counts.
+  const AnalogCalibration *calibration;
 };
 
+constexpr bool AnalogSensorSettingsValid(const AnalogSensorContext &ctx) {
+  return ctx.accumulateLog2 <= kAnalogMaxAccumulateLog2 &&
+         ctx.extraBits * 2U <= ctx.accumulateLog2 &&
+         ((ctx.mode != AnalogMode::Triggered &&
+           ctx.mode != AnalogMode::Windowed) ||
+          (ctx.triggerPeriodUs <= kAnalogMaxTriggerPeriodUs &&
+           ctx.triggerPeriodUs >
+               static_cast<uint32_t>(kAnalogConversionUs)
+                   << ctx.accumulateLog2));
+}
+
 bool AnalogSensorBegin(const void *ctx);
 bool AnalogSensorSample(const void *ctx, CANFDMessage &outFrame);
+bool AnalogSensorSampleScan(const void *ctx, CANFDMessage &outFrame);
+// Triggered and Windowed modes.
+bool AnalogSensorSampleTriggered(const void *ctx, CANFDMessage &outFrame);
+void AnalogSensorSuspend(const void *ctx);
+void AnalogSensorResume(const void *ctx);
+void AnalogSensorAttachDataReady(const void *ctx, void (*onReady)());
 
 constexpr SensorDescriptor MakeAnalogSensor(const AnalogSensorContext *ctx) {
   return SensorDescriptor{
       .context = ctx,
+      .base = ctx != nullptr ? &ctx->base : nullptr,
       .begin = AnalogSensorBegin,
-      .sample = AnalogSensorSample,
-      .suspend = nullptr,
-      .resume = nullptr,
+      .sample = ctx == nullptr ? AnalogSensorSample
+                : ctx->mode == AnalogMode::Scan ? AnalogSensorSampleScan
+                : ctx->mode == AnalogMode::Triggered ||
+                        ctx->mode == AnalogMode::Windowed
+                    ? AnalogSensorSampleTriggered
+                    : AnalogSensorSample,
+      .suspend = AnalogSensorSuspend,
+      .resume = AnalogSensorResume,
+      .attachDataReady = ctx != nullptr && ctx->mode == AnalogMode::Triggered
+                             ? AnalogSensorAttachDataReady
+                             : nullptr,
   };
 }
+
+// Analog modes are recognized by their sample function, which
+// MakeAnalogSensor picks from the mode.
+constexpr bool IsAnalogScanSensor(const SensorDescriptor &desc) {
+  return desc.sample == AnalogSensorSampleScan;
+}
+
+constexpr size_t CountAnalogScanSensors(const SensorDescriptor *sensors,
+                                        const size_t count) {
+  size_t scanCount = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (IsAnalogScanSensor(sensors[i])) {
+      ++scanCount;
+    }
+  }
+  return scanCount;
+}
+
+// A Triggered or Windowed sensor owns ADC0 and TCB0, so it must be the only
+// analog sensor on the board. main.cpp checks the board table with this;
+// begin() enforces the same rule at runtime.
+constexpr bool AnalogAdcOwnershipValid(const SensorDescriptor *sensors,
+                                       const size_t count) {
+  size_t analogCount = 0;
+  size_t exclusiveCount = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (sensors[i].begin == AnalogSensorBegin) {
+      ++analogCount;
+    }
+    if (sensors[i].sample == AnalogSensorSampleTriggered) {
+      ++exclusiveCount;
+    }
+  }
+  return exclusiveCount == 0U || (exclusiveCount == 1U && analogCount == 1U);
+}
+
+// Scan pass order, taken from the board's sensor table. Build it with
+// MakeAnalogScanTable() into a constexpr (BAJACAN_FLASH_TABLE) object.
+struct AnalogScanTable {
+  const void *contexts[kAnalogMaxScanChannels];
+  uint8_t count;
+};
+
+constexpr AnalogScanTable MakeAnalogScanTable(const SensorDescriptor *sensors,
+                                              const size_t count) {
+  AnalogScanTable table{};
+  for (size_t i = 0; i < count && table.count < kAnalogMaxScanChannels; ++i) {
+    if (IsAnalogScanSensor(sensors[i])) {
+      table.contexts[table.count++] = sensors[i].context;
+    }
+  }
+  return table;
+}
+
+// Resolves each channel's ADC0 settings once. Call before the Scan sensors'
+// begin(); returns false (and leaves them failing begin()) if a channel is
+// invalid or the references disagree.
+bool AnalogScanBegin(const AnalogScanTable &table);
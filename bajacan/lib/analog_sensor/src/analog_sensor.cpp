@@ -5,25 +5,628 @@ namespace {
 const AnalogSensorContext *GetAnalogContext(const void *ctx) {
   return static_cast<const AnalogSensorContext *>(ctx);
 }
+
+// Sums of more than 16 conversions do not fit RES, so ADC0 drops the low bits
+// itself and reports only the 16 MSBs.
+constexpr uint8_t kAdcFullSumLog2 = 4;
+
+uint8_t HardwareShift(const uint8_t accumulateLog2) {
+  return accumulateLog2 > kAdcFullSumLog2 ? accumulateLog2 - kAdcFullSumLog2
+                                          : 0;
+}
+
+// Turns RES into the value sent on the bus: decimated, then calibrated.
+// Differential results are two's complement and are shifted as such.
+uint16_t Decimate(const AnalogSensorContext &config, const uint16_t raw) {
+  const uint8_t shift = config.accumulateLog2 - config.extraBits -
+                        HardwareShift(config.accumulateLog2);
+  const int32_t reading = config.differential
+                              ? static_cast<int16_t>(raw) >> shift
+                              : static_cast<int32_t>(raw >> shift);
+  if (config.calibration == nullptr) {
+    return static_cast<uint16_t>(reading);
+  }
+  return static_cast<uint16_t>(ApplyCalibration(*config.calibration, reading));
+}
+
+// Everything one conversion needs, resolved from the context up front so the
+// scan interrupt only copies bytes into ADC0.
+struct AdcChannelConfig {
+  uint8_t muxpos;
+  uint8_t muxneg;
+  uint8_t convmode;  // ADC_CONVMODE_bm for differential.
+  uint8_t sampnum;
+  uint8_t refsel;    // kKeepReference leaves VREF.ADC0REF alone.
+  uint8_t sampctrl;  // 0 keeps the baseline sample length.
+};
+
+constexpr uint8_t kKeepReference = 0xFF;
+
+uint8_t ReferenceSelect(const AnalogReference reference) {
+  switch (reference) {
+    case AnalogReference::Vdd:
+      return VREF_REFSEL_VDD_gc;
+    case AnalogReference::Internal1V024:
+      return VREF_REFSEL_1V024_gc;
+    case AnalogReference::Internal2V048:
+      return VREF_REFSEL_2V048_gc;
+    case AnalogReference::Internal2V500:
+      return VREF_REFSEL_2V500_gc;
+    case AnalogReference::Internal4V096:
+      return VREF_REFSEL_4V096_gc;
+    case AnalogReference::External:
+      return VREF_REFSEL_VREFA_gc;
+    case AnalogReference::Default:
+      break;
+  }
+  return kKeepReference;
+}
+
+AdcChannelConfig ChannelFor(const AnalogSensorContext &config) {
+  return AdcChannelConfig{
+      digitalPinToAnalogInput(config.pin),
+      config.differential ? digitalPinToAnalogInput(config.negativePin)
+                          : static_cast<uint8_t>(ADC_MUXNEG_GND_gc),
+      static_cast<uint8_t>(config.differential ? ADC_CONVMODE_bm : 0U),
+      static_cast<uint8_t>(config.accumulateLog2 & ADC_SAMPNUM_gm),
+      ReferenceSelect(config.reference),
+      config.sampleLength,
+  };
+}
+
+// ADC0 settings as DxCore left them, restored after every conversion we make
+// so analogRead in board hooks keeps working. The reference is the exception:
+// restoring it would force a settling delay on every poll.
+struct AdcBaseline {
+  uint8_t ctrla;
+  uint8_t ctrlb;
+  uint8_t sampctrl;
+  uint8_t muxneg;
+};
+
+AdcBaseline gBaseline;
+bool gBaselineCaptured = false;
+
+void CaptureBaseline() {
+  if (gBaselineCaptured) {
+    return;
+  }
+  ADC0.CTRLA |= ADC_ENABLE_bm;
+  gBaseline = AdcBaseline{ADC0.CTRLA, ADC0.CTRLB, ADC0.SAMPCTRL, ADC0.MUXNEG};
+  gBaselineCaptured = true;
+}
+
+void RestoreBaseline() {
+  ADC0.CTRLA = gBaseline.ctrla;
+  ADC0.CTRLB = gBaseline.ctrlb;
+  ADC0.SAMPCTRL = gBaseline.sampctrl;
+  ADC0.MUXNEG = gBaseline.muxneg;
+}
+
+// Returns true when the reference changed and needs time to settle.
+bool ApplyChannel(const AdcChannelConfig &channel) {
+  bool referenceChanged = false;
+  if (channel.refsel != kKeepReference &&
+      (VREF.ADC0REF & VREF_REFSEL_gm) != channel.refsel) {
+    VREF.ADC0REF = (VREF.ADC0REF & ~VREF_REFSEL_gm) | channel.refsel;
+    referenceChanged = true;
+  }
+  ADC0.MUXPOS = channel.muxpos;
+  ADC0.MUXNEG = channel.muxneg;
+  // DxCore leaves ADC0 at 10 bits for analogRead(); every result here is
+  // decimated and calibrated as 12-bit.
+  ADC0.CTRLA = (gBaseline.ctrla & ~(ADC_CONVMODE_bm | ADC_RESSEL_gm)) |
+               ADC_RESSEL_12BIT_gc | channel.convmode;
+  ADC0.CTRLB = (gBaseline.ctrlb & ~ADC_SAMPNUM_gm) | channel.sampnum;
+  ADC0.SAMPCTRL =
+      channel.sampctrl != 0U ? channel.sampctrl : gBaseline.sampctrl;
+  return referenceChanged;
+}
+
+// The Triggered or Windowed sensor, if any; it owns ADC0 exclusively.
+const AnalogSensorContext *gTriggered = nullptr;
+// Set once a Blocking sensor has begun, so a later Triggered or Windowed
+// sensor is rejected too, not only the other way around.
+bool gBlockingBegun = false;
+
+// Scan channels come from the board's sensor table at compile time (see
+// AnalogScanTable); AnalogScanBegin() resolves each one's ADC0 settings once.
+struct ScanChannel {
+  const AnalogSensorContext *owner;
+  AdcChannelConfig adc;
+};
+
+ScanChannel gScanChannels[kAnalogMaxScanChannels];
+uint8_t gScanCount = 0;
+bool gScanValid = false;
+// The ISR fills gScanResults[gScanFront ^ 1] and flips gScanFront once the
+// pass is complete, so sample() always reads a consistent pass.
+volatile uint16_t gScanResults[2][kAnalogMaxScanChannels];
+volatile uint8_t gScanFront = 0;
+volatile uint8_t gScanNext = 0;
+volatile bool gScanBusy = false;
+volatile bool gScanHasResults = false;
+// Set when a conversion had to switch the reference (a Blocking sensor on
+// another one ran in between): the ISR throws that result away and converts
+// the channel again.
+volatile bool gScanSettling = false;
+// Set while a Blocking sensor owns ADC0; the scan timer skips that tick.
+volatile bool gBlockingActive = false;
+
+bool StartScanConversion(const ScanChannel &channel) {
+  const bool referenceChanged = ApplyChannel(channel.adc);
+  ADC0.COMMAND = ADC_STCONV_bm;
+  return referenceChanged;
+}
+
+// Called from the scan timer's interrupt.
+void StartScanPass() {
+  if (gScanBusy || gBlockingActive || gScanCount == 0U) {
+    return;
+  }
+  gScanBusy = true;
+  gScanNext = 0;
+  ADC0.INTFLAGS = ADC_RESRDY_bm;
+  ADC0.INTCTRL = ADC_RESRDY_bm;
+  gScanSettling = StartScanConversion(gScanChannels[0]);
+}
+
+// Scan passes run every BAJACAN_ANALOG_SCAN_PERIOD_US from TCB0, which is
+// free because Scan sensors never share a board with Triggered or Windowed.
+void StartScanTimer() {
+  const uint32_t ticksPerUs = F_CPU / 2000000UL;
+  TCB0.CTRLA = 0;
+  TCB0.CTRLB = TCB_CNTMODE_INT_gc;
+  TCB0.CCMP =
+      static_cast<uint16_t>(BAJACAN_ANALOG_SCAN_PERIOD_US * ticksPerUs - 1U);
+  TCB0.CNT = 0;
+  TCB0.INTFLAGS = TCB_CAPT_bm;
+  TCB0.INTCTRL = TCB_CAPT_bm;
+  TCB0.CTRLA = TCB_CLKSEL_DIV2_gc | TCB_ENABLE_bm;
+}
+
+void StopScanTimer() {
+  TCB0.CTRLA = 0;
+  TCB0.INTCTRL = 0;
+}
+
+// Blocking reads share ADC0 with the scan: wait out a running pass, then hold
+// further passes off until ReleaseAdc().
+void AcquireAdcForBlocking() {
+  for (;;) {
+    const uint8_t sreg = SREG;
+    noInterrupts();
+    if (!gScanBusy) {
+      gBlockingActive = true;
+      SREG = sreg;
+      return;
+    }
+    SREG = sreg;
+  }
+}
+
+void ReleaseAdc() { gBlockingActive = false; }
+
+int8_t FindScanChannel(const AnalogSensorContext *config) {
+  for (uint8_t i = 0; i < gScanCount; ++i) {
+    if (gScanChannels[i].owner == config) {
+      return static_cast<int8_t>(i);
+    }
+  }
+  return -1;
+}
+
+// Triggered mode: the ISR appends to the ring and advances gTriggeredWritten,
+// sample() consumes from gTriggeredRead. Both count samples since begin and
+// double as the frame sequence number.
+constexpr uint8_t kTriggeredRingSize = 64;
+constexpr uint8_t kTriggeredRingMask = kTriggeredRingSize - 1U;
+static_assert((kTriggeredRingSize & kTriggeredRingMask) == 0U,
+              "Triggered ring size must be a power of two");
+static_assert(kTriggeredRingSize >= kAnalogTriggeredFrameSamples,
+              "Triggered ring must hold a full frame");
+constexpr uint8_t kTriggeredHeaderBytes = 4;
+constexpr uint8_t kTriggeredDroppedFlag = 0x01;
+
+volatile uint16_t gTriggeredRing[kTriggeredRingSize];
+volatile uint16_t gTriggeredWritten = 0;
+volatile uint16_t gTriggeredRead = 0;
+bool gTriggeredDropped = false;
+void (*gTriggeredOnReady)() = nullptr;
+
+// Windowed mode: running statistics of calibrated samples, reset by sample().
+// sum cannot overflow: 65535 samples of at most 2^15 fit int32. Squares are
+// added pre-shifted right by squareShift, which grows by one whenever the next
+// one would carry out of sumSquares, so the sums stay in 32 bits without a
+// cap on the window length.
+struct WindowStats {
+  int16_t min;
+  int16_t max;
+  int32_t sum;
+  uint32_t sumSquares;
+  uint8_t squareShift;
+  uint16_t count;
+};
+
+volatile WindowStats gWindow;
+constexpr uint8_t kWindowedFrameBytes = 10;
+
+void PutReading(CANFDMessage &outFrame, const uint16_t reading) {
+  outFrame.len = 2;
+  outFrame.data[0] = reading >> 8;
+  outFrame.data[1] = reading & 0xFF;
+}
+
+void ResetWindow() {
+  gWindow.count = 0;
+  gWindow.sum = 0;
+  gWindow.sumSquares = 0;
+  gWindow.squareShift = 0;
+}
+
+uint32_t SquareRoot(uint32_t value) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit != 0U) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+void StartTriggerTimer() {
+  TCB0.CTRLA = TCB_CLKSEL_DIV2_gc | TCB_ENABLE_bm;
+}
+
+void StopTriggerTimer() { TCB0.CTRLA = 0; }
+
+bool BeginTriggered(const AnalogSensorContext *config) {
+  if (gTriggered != nullptr || gBlockingBegun || gScanCount > 0U) {
+    return false;
+  }
+  gTriggered = config;
+  const uint32_t ticksPerUs = F_CPU / 2000000UL;
+  StopTriggerTimer();
+  TCB0.CTRLB = TCB_CNTMODE_INT_gc;  // Periodic; CAPT event every period.
+  TCB0.INTCTRL = 0;
+  TCB0.CCMP = static_cast<uint16_t>(config->triggerPeriodUs * ticksPerUs - 1U);
+  TCB0.CNT = 0;
+  EVSYS.CHANNEL0 = EVSYS_CHANNEL0_TCB0_CAPT_gc;
+  EVSYS.USERADC0START = EVSYS_USER_CHANNEL0_gc;
+
+  ApplyChannel(ChannelFor(*config));
+  ADC0.EVCTRL = ADC_STARTEI_bm;
+  ADC0.INTFLAGS = ADC_RESRDY_bm;
+  ADC0.INTCTRL = ADC_RESRDY_bm;
+  StartTriggerTimer();
+  return true;
+}
+
+void OnWindowedResult() {
+  const int16_t value =
+      static_cast<int16_t>(Decimate(*gTriggered, ADC0.RES));  // Clears RESRDY.
+  if (gWindow.count == UINT16_MAX) {
+    return;  // Window far longer than intended; keep what we have.
+  }
+  if (gWindow.count == 0U || value < gWindow.min) {
+    gWindow.min = value;
+  }
+  if (gWindow.count == 0U || value > gWindow.max) {
+    gWindow.max = value;
+  }
+  gWindow.sum += value;
+  const int32_t fullSquare = static_cast<int32_t>(value) * value;
+  uint32_t square = static_cast<uint32_t>(fullSquare) >> gWindow.squareShift;
+  uint32_t sumSquares = gWindow.sumSquares;
+  while (square > UINT32_MAX - sumSquares) {
+    sumSquares >>= 1;
+    square >>= 1;
+    gWindow.squareShift = gWindow.squareShift + 1U;
+  }
+  gWindow.sumSquares = sumSquares + square;
+  ++gWindow.count;
+}
+
+void OnTriggeredResult() {
+  const uint16_t written = gTriggeredWritten;
+  gTriggeredRing[written & kTriggeredRingMask] = ADC0.RES;  // Clears RESRDY.
+  gTriggeredWritten = written + 1U;
+  if (static_cast<uint16_t>(written + 1U - gTriggeredRead) ==
+          kAnalogTriggeredFrameSamples &&
+      gTriggeredOnReady != nullptr) {
+    gTriggeredOnReady();
+  }
+}
+
+bool SampleTriggered(const AnalogSensorContext &config,
+                     CANFDMessage &outFrame) {
+  // Raw results are copied into the frame with interrupts masked, then
+  // decimated and calibrated in place so the CAN, TWI and capture ISRs are
+  // only held off for the copy.
+  uint8_t at = kTriggeredHeaderBytes;
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  const uint16_t written = gTriggeredWritten;
+  uint16_t read = gTriggeredRead;
+  if (static_cast<uint16_t>(written - read) > kTriggeredRingSize) {
+    read = written - kTriggeredRingSize;  // Oldest samples were overwritten.
+    gTriggeredDropped = true;
+  }
+  const uint16_t first = read;
+  while (read != written && at < sizeof(outFrame.data)) {
+    const uint16_t raw = gTriggeredRing[read & kTriggeredRingMask];
+    outFrame.data[at++] = raw >> 8;
+    outFrame.data[at++] = raw & 0xFF;
+    ++read;
+  }
+  gTriggeredRead = read;
+  SREG = sreg;
+
+  for (uint8_t i = kTriggeredHeaderBytes; i < at; i += 2U) {
+    const uint16_t raw = (static_cast<uint16_t>(outFrame.data[i]) << 8) |
+                         outFrame.data[i + 1];
+    const uint16_t value = Decimate(config, raw);
+    outFrame.data[i] = value >> 8;
+    outFrame.data[i + 1] = value & 0xFF;
+  }
+  if (read == first) {
+    return false;
+  }
+  outFrame.data[0] = first >> 8;
+  outFrame.data[1] = first & 0xFF;
+  outFrame.data[2] = static_cast<uint8_t>(read - first);
+  outFrame.data[3] = gTriggeredDropped ? kTriggeredDroppedFlag : 0U;
+  gTriggeredDropped = false;
+  outFrame.len = at;
+  outFrame.pad();
+  return true;
+}
+
+bool SampleWindowed(CANFDMessage &outFrame) {
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  const int16_t min = gWindow.min;
+  const int16_t max = gWindow.max;
+  const int32_t sum = gWindow.sum;
+  const uint32_t sumSquares = gWindow.sumSquares;
+  const uint8_t squareShift = gWindow.squareShift;
+  const uint16_t count = gWindow.count;
+  ResetWindow();
+  SREG = sreg;
+
+  if (count == 0U) {
+    return false;
+  }
+  const int16_t mean = static_cast<int16_t>(sum / count);
+  // The mean square of int16 samples is at most 2^30, so shifting it back up
+  // stays within 32 bits.
+  const uint32_t rms = SquareRoot((sumSquares / count) << squareShift);
+  const uint16_t fields[] = {
+      static_cast<uint16_t>(min), static_cast<uint16_t>(max),
+      static_cast<uint16_t>(mean), static_cast<uint16_t>(rms), count,
+  };
+  uint8_t at = 0;
+  for (const uint16_t field : fields) {
+    outFrame.data[at++] = field >> 8;
+    outFrame.data[at++] = field & 0xFF;
+  }
+  outFrame.len = kWindowedFrameBytes;
+  outFrame.pad();
+  return true;
+}
+
+uint16_t ConvertOnce() {
+  ADC0.COMMAND = ADC_STCONV_bm;
+  while ((ADC0.INTFLAGS & ADC_RESRDY_bm) == 0U) {
+  }
+  return ADC0.RES;  // Reading RES clears RESRDY.
+}
+
+bool SampleBlocking(const AnalogSensorContext &config, uint16_t &reading) {
+  if (gTriggered != nullptr) {
+    return false;
+  }
+  AcquireAdcForBlocking();
+  if (ApplyChannel(ChannelFor(config))) {
+    ConvertOnce();  // First result after a reference switch is unreliable.
+  }
+  reading = Decimate(config, ConvertOnce());
+  RestoreBaseline();
+  ReleaseAdc();
+  return true;
+}
+
+bool SampleScan(const AnalogSensorContext &config, uint16_t &reading) {
+  const int8_t slot = FindScanChannel(&config);
+  if (slot < 0) {
+    return false;
+  }
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  const bool hasResults = gScanHasResults;
+  const uint16_t raw = gScanResults[gScanFront][slot];
+  SREG = sreg;
+  if (!hasResults) {
+    return false;
+  }
+  reading = Decimate(config, raw);
+  return true;
+}
+}
+
+ISR(TCB0_INT_vect) {
+  TCB0.INTFLAGS = TCB_CAPT_bm;
+  StartScanPass();
+}
+
+ISR(ADC0_RESRDY_vect) {
+  if (gTriggered != nullptr) {
+    if (gTriggered->mode == AnalogMode::Windowed) {
+      OnWindowedResult();
+    } else {
+      OnTriggeredResult();
+    }
+    return;
+  }
+  if (gScanSettling) {
+    gScanSettling = false;
+    static_cast<void>(ADC0.RES);  // Clears RESRDY.
+    ADC0.COMMAND = ADC_STCONV_bm;
+    return;
+  }
+  const uint8_t back = gScanFront ^ 1U;
+  gScanResults[back][gScanNext] = ADC0.RES;  // Clears RESRDY.
+  if (++gScanNext < gScanCount) {
+    gScanSettling = StartScanConversion(gScanChannels[gScanNext]);
+    return;
+  }
+  ADC0.INTCTRL = 0;
+  RestoreBaseline();
+  gScanFront = back;
+  gScanHasResults = true;
+  gScanBusy = false;
 }
 
 bool AnalogSensorBegin(const void *ctx) {
   const AnalogSensorContext *config = GetAnalogContext(ctx);
-  if (config == nullptr) {
+  if (config == nullptr || !AnalogSensorSettingsValid(*config)) {
+    return false;
+  }
+  if (digitalPinToAnalogInput(config->pin) == NOT_A_PIN ||
+      (config->differential &&
+       digitalPinToAnalogInput(config->negativePin) == NOT_A_PIN)) {
     return false;
   }
   pinMode(config->pin, INPUT);
+  if (config->differential) {
+    pinMode(config->negativePin, INPUT);
+  }
+  CaptureBaseline();
+  if (config->mode == AnalogMode::Scan) {
+    if (gTriggered != nullptr || !gScanValid ||
+        FindScanChannel(config) < 0) {
+      return false;
+    }
+    if ((TCB0.CTRLA & TCB_ENABLE_bm) == 0U) {
+      StartScanTimer();
+    }
+    return true;
+  }
+  if (config->mode == AnalogMode::Triggered ||
+      config->mode == AnalogMode::Windowed) {
+    ResetWindow();
+    return BeginTriggered(config);
+  }
+  if (gTriggered != nullptr) {
+    return false;
+  }
+  gBlockingBegun = true;
   return true;
 }
 
 bool AnalogSensorSample(const void *ctx, CANFDMessage &outFrame) {
   const AnalogSensorContext *config = GetAnalogContext(ctx);
-  if (config == nullptr) {
+  uint16_t reading = 0;
+  if (config == nullptr || !SampleBlocking(*config, reading)) {
     return false;
   }
-  const uint16_t reading = analogRead(config->pin);
-  outFrame.len = 2;
-  outFrame.data[0] = reading >> 8;
-  outFrame.data[1] = reading & 0xFF;
+  PutReading(outFrame, reading);
+  return true;
+}
+
+bool AnalogSensorSampleTriggered(const void *ctx, CANFDMessage &outFrame) {
+  const AnalogSensorContext *config = GetAnalogContext(ctx);
+  if (config == nullptr || config != gTriggered) {
+    return false;
+  }
+  return config->mode == AnalogMode::Windowed
+             ? SampleWindowed(outFrame)
+             : SampleTriggered(*config, outFrame);
+}
+
+bool AnalogSensorSampleScan(const void *ctx, CANFDMessage &outFrame) {
+  const AnalogSensorContext *config = GetAnalogContext(ctx);
+  uint16_t reading = 0;
+  if (config == nullptr || !SampleScan(*config, reading)) {
+    return false;
+  }
+  PutReading(outFrame, reading);
   return true;
 }
+
+bool AnalogScanBegin(const AnalogScanTable &table) {
+  gScanCount = 0;
+  gScanValid = false;
+  if (table.count > kAnalogMaxScanChannels) {
+    return false;
+  }
+  for (uint8_t i = 0; i < table.count; ++i) {
+    const AnalogSensorContext *config = GetAnalogContext(table.contexts[i]);
+    if (config == nullptr || !AnalogSensorSettingsValid(*config) ||
+        digitalPinToAnalogInput(config->pin) == NOT_A_PIN ||
+        (config->differential &&
+         digitalPinToAnalogInput(config->negativePin) == NOT_A_PIN)) {
+      return false;
+    }
+    const AdcChannelConfig adc = ChannelFor(*config);
+    // The pass runs back to back from the interrupt with no time for VREF to
+    // settle, so every Scan channel must use the same reference.
+    for (uint8_t j = 0; j < i; ++j) {
+      const uint8_t refsel = gScanChannels[j].adc.refsel;
+      if (refsel != kKeepReference && adc.refsel != kKeepReference &&
+          refsel != adc.refsel) {
+        return false;
+      }
+    }
+    gScanChannels[i] = ScanChannel{config, adc};
+  }
+  gScanCount = table.count;
+  gScanValid = true;
+  return true;
+}
+
+void AnalogSensorSuspend(const void *ctx) {
+  const AnalogSensorContext *config = GetAnalogContext(ctx);
+  if (config == nullptr) {
+    return;
+  }
+  if (config == gTriggered) {
+    StopTriggerTimer();
+  } else if (config->mode == AnalogMode::Scan) {
+    StopScanTimer();  // Every Scan sensor calls this; the first one stops it.
+  }
+}
+
+void AnalogSensorResume(const void *ctx) {
+  const AnalogSensorContext *config = GetAnalogContext(ctx);
+  if (config != nullptr && config->mode == AnalogMode::Scan && gScanValid &&
+      (TCB0.CTRLA & TCB_ENABLE_bm) == 0U) {
+    StartScanTimer();
+    return;
+  }
+  if (config == nullptr || config != gTriggered) {
+    return;
+  }
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  gTriggeredRead = gTriggeredWritten;  // Discard samples from before sleep.
+  ResetWindow();
+  SREG = sreg;
+  gTriggeredDropped = true;
+  TCB0.CNT = 0;
+  StartTriggerTimer();
+}
+
+void AnalogSensorAttachDataReady(const void *ctx, void (*onReady)()) {
+  if (ctx != nullptr && GetAnalogContext(ctx) == gTriggered) {
+    gTriggeredOnReady = onReady;
+  }
+}
@@ -0,0 +1,50 @@
+// Interrupt-driven TWI0 host. Callers queue I2cTransaction objects they own
+// (no allocation); the TWI interrupt walks each one through address, write,
+// repeated start and read without the main loop waiting on the bus, then
+// sets its status and calls its completion callback.
+//
+// Replaces Wire for sensors on the node; do not mix the two on TWI0.
+
+#pragma once
+
+#include <stdint.h>
+
+enum class I2cStatus : uint8_t {
+  Idle,     // Never submitted.
+  Pending,  // Queued or on the bus.
+  Done,
+  Nack,      // Address or data byte not acknowledged.
+  BusError,  // Bus error or arbitration lost.
+};
+
+struct I2cTransaction {
+  uint8_t address;  // 7-bit.
+  // Written first; a read follows with a repeated start. Either may be empty.
+  const uint8_t *writeData;
+  uint8_t writeLength;
+  uint8_t *readData;
+  uint8_t readLength;
+  // Runs in the TWI interrupt once status is final; may submit transactions,
+  // including this one. nullptr to poll status instead.
+  void (*onComplete)(I2cTransaction &transaction);
+  void *user;  // For the callback.
+
+  volatile I2cStatus status;
+  I2cTransaction *next;  // Queue link, owned by the engine.
+};
+
+constexpr uint32_t kI2cDefaultClockHz = 400000UL;
+
+// Enables TWI0 as bus host on its default pins; external pull-ups required.
+// Later calls are no-ops, so every I2C sensor can call it from begin().
+void I2cAsyncBegin(uint32_t clockHz = kI2cDefaultClockHz);
+// Queues the transaction; false if it is still pending from before.
+// ISR-safe. Buffers must stay valid until the status leaves Pending.
+bool I2cAsyncSubmit(I2cTransaction &transaction);
+// True when nothing is queued or on the bus.
+bool I2cAsyncIdle();
+// Gives up on a transaction that is still Pending, e.g. after a caller's
+// timeout: if it is on the bus a STOP is issued and the next one started.
+// Its status becomes BusError and its callback runs, here rather than in the
+// TWI interrupt. False if it was not pending.
+bool I2cAsyncAbort(I2cTransaction &transaction);
@@ -0,0 +1,157 @@
+#include <Arduino.h>
+#include <i2c_async.h>
+
+namespace {
+// Queue of submitted transactions; the head is the one on the bus. Only
+// touched with interrupts masked or from the TWI interrupt.
+I2cTransaction *gHead = nullptr;
+I2cTransaction *gTail = nullptr;
+bool gActive = false;
+uint8_t gIndex = 0;     // Byte position within the current phase.
+bool gReading = false;  // Phase of the head transaction.
+
+constexpr uint8_t kReadBit = 0x01;
+constexpr uint8_t kMinBaud = 1;
+
+uint8_t BaudFor(const uint32_t clockHz) {
+  // Datasheet: f_SCL = F_CPU / (10 + 2 * BAUD), rise time neglected.
+  const uint32_t baud = F_CPU / (2UL * clockHz);
+  return baud > 255UL + 5UL ? 255U
+                            : (baud > 5UL + kMinBaud ? baud - 5UL : kMinBaud);
+}
+
+void StartHead() {
+  I2cTransaction &transaction = *gHead;
+  gActive = true;
+  gIndex = 0;
+  gReading = transaction.writeLength == 0U;
+  TWI0.MADDR = static_cast<uint8_t>(transaction.address << 1) |
+               (gReading ? kReadBit : 0U);
+}
+
+void Finish(const I2cStatus status) {
+  I2cTransaction &transaction = *gHead;
+  gHead = transaction.next;
+  if (gHead == nullptr) {
+    gTail = nullptr;
+  }
+  gActive = false;
+  transaction.status = status;
+  if (transaction.onComplete != nullptr) {
+    transaction.onComplete(transaction);  // May submit and start the bus.
+  }
+  if (!gActive && gHead != nullptr) {
+    StartHead();
+  }
+}
+
+void OnHostInterrupt() {
+  const uint8_t status = TWI0.MSTATUS;
+  if ((status & (TWI_ARBLOST_bm | TWI_BUSERR_bm)) != 0U) {
+    // Another host or a glitch owns the bus; no STOP, just resync.
+    TWI0.MSTATUS = TWI_ARBLOST_bm | TWI_BUSERR_bm | TWI_BUSSTATE_IDLE_gc;
+    Finish(I2cStatus::BusError);
+    return;
+  }
+  I2cTransaction &transaction = *gHead;
+  if ((status & TWI_WIF_bm) != 0U) {
+    if ((status & TWI_RXACK_bm) != 0U) {
+      TWI0.MCTRLB = TWI_MCMD_STOP_gc;
+      Finish(I2cStatus::Nack);
+    } else if (!gReading && gIndex < transaction.writeLength) {
+      TWI0.MDATA = transaction.writeData[gIndex++];
+    } else if (!gReading && transaction.readLength > 0U) {
+      gReading = true;
+      gIndex = 0;
+      TWI0.MADDR = static_cast<uint8_t>(transaction.address << 1) | kReadBit;
+    } else {
+      TWI0.MCTRLB = TWI_MCMD_STOP_gc;
+      Finish(I2cStatus::Done);
+    }
+    return;
+  }
+  if ((status & TWI_RIF_bm) != 0U) {
+    const uint8_t data = TWI0.MDATA;
+    if (gIndex < transaction.readLength) {
+      transaction.readData[gIndex++] = data;
+    }
+    if (gIndex < transaction.readLength) {
+      TWI0.MCTRLB = TWI_MCMD_RECVTRANS_gc;
+    } else {
+      TWI0.MCTRLB = TWI_ACKACT_bm | TWI_MCMD_STOP_gc;  // NACK the last byte.
+      Finish(I2cStatus::Done);
+    }
+  }
+}
+}
+
+ISR(TWI0_TWIM_vect) { OnHostInterrupt(); }
+
+void I2cAsyncBegin(const uint32_t clockHz) {
+  if ((TWI0.MCTRLA & TWI_ENABLE_bm) != 0U) {
+    return;
+  }
+  TWI0.MBAUD = BaudFor(clockHz);
+  TWI0.MCTRLA = TWI_RIEN_bm | TWI_WIEN_bm | TWI_TIMEOUT_200US_gc |
+                TWI_ENABLE_bm;
+  TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;
+}
+
+bool I2cAsyncSubmit(I2cTransaction &transaction) {
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  if (transaction.status == I2cStatus::Pending) {
+    SREG = sreg;
+    return false;
+  }
+  transaction.status = I2cStatus::Pending;
+  transaction.next = nullptr;
+  if (gTail != nullptr) {
+    gTail->next = &transaction;
+  } else {
+    gHead = &transaction;
+  }
+  gTail = &transaction;
+  if (!gActive) {
+    StartHead();
+  }
+  SREG = sreg;
+  return true;
+}
+
+bool I2cAsyncIdle() {
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  const bool idle = gHead == nullptr;
+  SREG = sreg;
+  return idle;
+}
+
+bool I2cAsyncAbort(I2cTransaction &transaction) {
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  if (transaction.status != I2cStatus::Pending) {
+    SREG = sreg;
+    return false;
+  }
+  if (&transaction == gHead) {
+    TWI0.MCTRLB = TWI_MCMD_STOP_gc;
+    Finish(I2cStatus::BusError);
+    SREG = sreg;
+    return true;
+  }
+  I2cTransaction *previous = gHead;
+  while (previous->next != &transaction) {
+    previous = previous->next;
+  }
+  previous->next = transaction.next;
+  if (gTail == &transaction) {
+    gTail = previous;
+  }
+  transaction.status = I2cStatus::BusError;
+  if (transaction.onComplete != nullptr) {
+    transaction.onComplete(transaction);
+  }
+  SREG = sreg;
+  return true;
+}
@@ -0,0 +1,66 @@
+// Generic I2C sensor that sends a block of device registers as-is, using the
+// two-phase contract on the interrupt-driven I2C engine so the loop never
+// waits on the bus. startConversion writes the optional start command (e.g. a
+// one-shot conversion trigger) or, without one, queues the block read.
+// collect queues the read after a start command, reports Pending while bus
+// transfers are in flight and Failed on a NACK or bus error.
+//
+// Set base.conversionMs to the device's conversion time, or to 1 without a
+// start command so the read has left the bus by the first collect.
+
+#pragma once
+
+#include <config.h>
+#include <i2c_async.h>
+#include <protothread.h>
+
+constexpr uint8_t kI2cRegisterMaxBytes = 16;
+
+// Mutable part of an I2C register sensor; define one per sensor in RAM.
+struct I2cRegisterSensorState {
+  I2cTransaction transaction;
+  Protothread collectTask;
+  uint8_t data[kI2cRegisterMaxBytes];
+};
+
+struct I2cRegisterSensorContext {
+  SensorContext base;
+  uint8_t address;  // 7-bit.
+  uint8_t reg;      // First register; the device must auto-increment.
+  uint8_t length;   // Bytes read and sent, 1..kI2cRegisterMaxBytes.
+  // Written (register address first) to start each conversion; optional.
+  const uint8_t *startCommand;
+  uint8_t startCommandLength;
+  // Bus clock; the first I2C sensor to begin() sets it for all of them.
+  uint32_t clockHz;
+  I2cRegisterSensorState *state;
+};
+
+constexpr bool I2cRegisterSensorSettingsValid(
+    const I2cRegisterSensorContext &ctx) {
+  return ctx.length > 0U && ctx.length <= kI2cRegisterMaxBytes &&
+         ctx.address < 0x80U && ctx.state != nullptr;
+}
+
+bool I2cRegisterSensorBegin(const void *ctx);
+bool I2cRegisterSensorStart(const void *ctx);
+SensorCollectResult I2cRegisterSensorCollect(const void *ctx,
+                                             CANFDMessage &outFrame);
+// Aborts a transfer the core gave up waiting for, freeing the queue.
+void I2cRegisterSensorCancel(const void *ctx);
+
+constexpr SensorDescriptor MakeI2cRegisterSensor(
+    const I2cRegisterSensorContext *ctx) {
+  return SensorDescriptor{
+      .context = ctx,
+      .base = ctx != nullptr ? &ctx->base : nullptr,
+      .begin = I2cRegisterSensorBegin,
+      .sample = nullptr,
+      .suspend = nullptr,
+      .resume = nullptr,
+      .attachDataReady = nullptr,
+      .startConversion = I2cRegisterSensorStart,
+      .collect = I2cRegisterSensorCollect,
+      .cancel = I2cRegisterSensorCancel,
+  };
+}
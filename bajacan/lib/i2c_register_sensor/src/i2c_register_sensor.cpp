@@ -0,0 +1,101 @@
+#include <Arduino.h>
+#include <i2c_register_sensor.h>
+
+namespace {
+const I2cRegisterSensorContext *GetI2cRegisterContext(const void *ctx) {
+  return static_cast<const I2cRegisterSensorContext *>(ctx);
+}
+
+// begin() may block; this bounds the probe read if the device is missing and
+// the bus hangs.
+constexpr uint32_t kProbeTimeoutUs = 5000;
+
+bool StartRead(const I2cRegisterSensorContext &config) {
+  I2cTransaction &transaction = config.state->transaction;
+  transaction.address = config.address;
+  transaction.writeData = &config.reg;
+  transaction.writeLength = 1;
+  transaction.readData = config.state->data;
+  transaction.readLength = config.length;
+  transaction.onComplete = nullptr;
+  return I2cAsyncSubmit(transaction);
+}
+
+bool StartCommand(const I2cRegisterSensorContext &config) {
+  I2cTransaction &transaction = config.state->transaction;
+  transaction.address = config.address;
+  transaction.writeData = config.startCommand;
+  transaction.writeLength = config.startCommandLength;
+  transaction.readData = nullptr;
+  transaction.readLength = 0;
+  transaction.onComplete = nullptr;
+  return I2cAsyncSubmit(transaction);
+}
+}
+
+// Reads the block once, waiting for it, so a missing device fails setup.
+bool I2cRegisterSensorBegin(const void *ctx) {
+  const I2cRegisterSensorContext *config = GetI2cRegisterContext(ctx);
+  if (config == nullptr || !I2cRegisterSensorSettingsValid(*config)) {
+    return false;
+  }
+  I2cAsyncBegin(config->clockHz);
+  if (!StartRead(*config)) {
+    return false;
+  }
+  const I2cTransaction &transaction = config->state->transaction;
+  const uint32_t startUs = micros();
+  while (transaction.status == I2cStatus::Pending &&
+         micros() - startUs < kProbeTimeoutUs) {
+  }
+  // A device holding the bus would otherwise block every later transaction.
+  I2cAsyncAbort(config->state->transaction);
+  return transaction.status == I2cStatus::Done;
+}
+
+// False if the previous conversion's transfer is somehow still on the bus.
+bool I2cRegisterSensorStart(const void *ctx) {
+  const I2cRegisterSensorContext *config = GetI2cRegisterContext(ctx);
+  if (config == nullptr) {
+    return false;
+  }
+  ProtothreadReset(config->state->collectTask);
+  return config->startCommandLength > 0U ? StartCommand(*config)
+                                         : StartRead(*config);
+}
+
+SensorCollectResult I2cRegisterSensorCollect(const void *ctx,
+                                             CANFDMessage &outFrame) {
+  const I2cRegisterSensorContext *config = GetI2cRegisterContext(ctx);
+  if (config == nullptr) {
+    return SensorCollectResult::Failed;
+  }
+  I2cRegisterSensorState &state = *config->state;
+  const I2cTransaction &transaction = state.transaction;
+  PT_BEGIN(state.collectTask);
+  if (config->startCommandLength > 0U) {
+    PT_WAIT_UNTIL(state.collectTask,
+                  transaction.status != I2cStatus::Pending);
+    // Conversion time has passed since the start command; fetch the result.
+    if (transaction.status != I2cStatus::Done || !StartRead(*config)) {
+      PT_EXIT(state.collectTask, SensorCollectResult::Failed);
+    }
+  }
+  PT_WAIT_UNTIL(state.collectTask, transaction.status != I2cStatus::Pending);
+  if (transaction.status != I2cStatus::Done) {
+    PT_EXIT(state.collectTask, SensorCollectResult::Failed);
+  }
+  memcpy(outFrame.data, state.data, config->length);
+  outFrame.len = config->length;
+  outFrame.pad();
+  PT_END(state.collectTask, SensorCollectResult::Ready);
+}
+
+void I2cRegisterSensorCancel(const void *ctx) {
+  const I2cRegisterSensorContext *config = GetI2cRegisterContext(ctx);
+  if (config == nullptr) {
+    return;
+  }
+  I2cAsyncAbort(config->state->transaction);
+  ProtothreadReset(config->state->collectTask);
+}
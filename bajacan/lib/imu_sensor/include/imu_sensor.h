@@ -0,0 +1,80 @@
+// TDK ICM-42688-P 6-axis IMU on the shared SPI bus. The IMU buffers
+// accel+gyro samples in its own FIFO at the configured ODR; each poll drains
+// up to kSensorMaxBatchFrames * kImuSamplesPerFrame of them in a single SPI
+// transaction and sends them as a batch of 64-byte frames, big-endian:
+//   [0..1] sample counter of the first sample (wraps)  [2] samples in frame
+//   [3] flags (bit 0: more samples follow in this batch or the FIFO)
+//   [4..63] samples, 12 bytes each: accel x/y/z then gyro x/y/z, int16
+// The counter advances for every sample read from the FIFO, including those
+// in frames the CAN driver then rejects (a partly sent batch), so a gap in the
+// counter on the bus marks dropped samples.
+// Poll at least every 20 ms at 1 kHz ODR to keep up, or wire INT1 and set
+// useFifoInterrupt so each batch goes out as soon as a frame's worth is
+// queued.
+//
+// Transfers go through the SPI bus arbiter, which holds the CAN controller's
+// interrupt off until each one ends.
+
+#pragma once
+
+#include <config.h>
+#include <spi_bus.h>
+
+constexpr uint8_t kImuSamplesPerFrame = 5;
+// Suggested spi.clockHz. The IMU allows 24 MHz; 8 MHz leaves margin for
+// long traces to the IMU.
+constexpr uint32_t kImuDefaultSpiHz = 8000000UL;
+
+// Output data rate, shared by accel and gyro (ACCEL/GYRO_CONFIG0 ODR codes).
+enum class ImuOdr : uint8_t {
+  Hz1000 = 0x06,
+  Hz500 = 0x0F,
+  Hz200 = 0x07,
+  Hz100 = 0x08,
+  Hz50 = 0x09,
+};
+
+// Full-scale ranges (ACCEL_FS_SEL / GYRO_FS_SEL codes).
+enum class ImuAccelRange : uint8_t { G16, G8, G4, G2 };
+enum class ImuGyroRange : uint8_t { Dps2000, Dps1000, Dps500, Dps250 };
+
+// Mutable part of an IMU sensor; define one per IMU in RAM.
+struct ImuSensorState {
+  uint16_t samples;  // Samples read from the FIFO so far (sent or not); wraps.
+};
+
+struct ImuSensorContext {
+  SensorContext base;
+  SpiDevice spi;  // SPI_MODE0 or SPI_MODE3.
+  ImuOdr odr;
+  ImuAccelRange accelRange;
+  ImuGyroRange gyroRange;
+  // Drive INT1 (on intPin) from the FIFO watermark and use it as the
+  // sensor's data-ready event; pollIntervalMs then only acts as a fallback.
+  bool useFifoInterrupt;
+  uint8_t intPin;
+  ImuSensorState *state;
+};
+
+bool ImuSensorBegin(const void *ctx);
+bool ImuSensorSampleBatch(const void *ctx, SensorFrameBatch &outFrames);
+void ImuSensorSuspend(const void *ctx);
+void ImuSensorResume(const void *ctx);
+void ImuSensorAttachDataReady(const void *ctx, void (*onReady)());
+
+constexpr SensorDescriptor MakeImuSensor(const ImuSensorContext *ctx) {
+  return SensorDescriptor{
+      .context = ctx,
+      .base = ctx != nullptr ? &ctx->base : nullptr,
+      .begin = ImuSensorBegin,
+      .sample = nullptr,
+      .suspend = ImuSensorSuspend,
+      .resume = ImuSensorResume,
+      .attachDataReady = ctx != nullptr && ctx->useFifoInterrupt
+                             ? ImuSensorAttachDataReady
+                             : nullptr,
+      .startConversion = nullptr,
+      .collect = nullptr,
+      .sampleBatch = ImuSensorSampleBatch,
+  };
+}
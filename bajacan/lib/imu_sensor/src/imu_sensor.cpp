@@ -0,0 +1,208 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <imu_sensor.h>
+#include <spi_bus.h>
+
+namespace {
+const ImuSensorContext *GetImuContext(const void *ctx) {
+  return static_cast<const ImuSensorContext *>(ctx);
+}
+
+// Bank 0 registers.
+constexpr uint8_t kRegDeviceConfig = 0x11;
+constexpr uint8_t kRegIntConfig = 0x14;
+constexpr uint8_t kRegFifoConfig = 0x16;
+constexpr uint8_t kRegFifoCountH = 0x2E;
+constexpr uint8_t kRegFifoData = 0x30;
+constexpr uint8_t kRegSignalPathReset = 0x4B;
+constexpr uint8_t kRegIntfConfig0 = 0x4C;
+constexpr uint8_t kRegPwrMgmt0 = 0x4E;
+constexpr uint8_t kRegGyroConfig0 = 0x4F;
+constexpr uint8_t kRegAccelConfig0 = 0x50;
+constexpr uint8_t kRegFifoConfig1 = 0x5F;
+constexpr uint8_t kRegFifoConfig2 = 0x60;
+constexpr uint8_t kRegFifoConfig3 = 0x61;
+constexpr uint8_t kRegIntConfig1 = 0x64;
+constexpr uint8_t kRegIntSource0 = 0x65;
+constexpr uint8_t kRegWhoAmI = 0x75;
+
+constexpr uint8_t kReadBit = 0x80;
+constexpr uint8_t kWhoAmI = 0x47;
+constexpr uint8_t kSoftReset = 0x01;
+// FIFO count in records, count and sample data big-endian.
+constexpr uint8_t kIntfConfig0 = 0x70;
+constexpr uint8_t kFifoStream = 0x40;
+constexpr uint8_t kFifoAccelGyro = 0x03;
+constexpr uint8_t kFifoWatermarkGreaterThan = 0x20;
+constexpr uint8_t kFifoFlush = 0x02;
+constexpr uint8_t kAccelGyroLowNoise = 0x0F;
+// INT1 pulsed, push-pull, active high.
+constexpr uint8_t kInt1PulsedPushPullHigh = 0x03;
+constexpr uint8_t kFifoThresholdInt1 = 0x04;
+
+// Packet 3: header, accel x/y/z, gyro x/y/z, temperature, timestamp.
+constexpr uint8_t kPacketBytes = 16;
+constexpr uint8_t kPacketSensorOffset = 1;
+constexpr uint8_t kSampleBytes = 12;
+constexpr uint8_t kHeaderEmpty = 0x80;
+constexpr uint8_t kHeaderFrame = 4;
+constexpr uint8_t kFlagBacklog = 0x01;
+static_assert(kHeaderFrame + kImuSamplesPerFrame * kSampleBytes <= 64,
+              "IMU samples must fit one CAN FD frame");
+constexpr uint8_t kImuSamplesPerPoll =
+    kImuSamplesPerFrame * kSensorMaxBatchFrames;
+
+constexpr uint16_t kResetSettleMs = 1;
+constexpr uint16_t kPowerOnSettleUs = 200;
+
+// Register accesses outside sample() are rare, so each is its own
+// transaction.
+void WriteRegister(const ImuSensorContext &config, const uint8_t reg,
+                   const uint8_t value) {
+  SpiBusAcquire(config.spi);
+  SPI.transfer(reg);
+  SPI.transfer(value);
+  SpiBusRelease(config.spi);
+}
+
+uint8_t ReadRegister(const ImuSensorContext &config, const uint8_t reg) {
+  SpiBusAcquire(config.spi);
+  SPI.transfer(reg | kReadBit);
+  const uint8_t value = SPI.transfer(0);
+  SpiBusRelease(config.spi);
+  return value;
+}
+
+void PowerOn(const ImuSensorContext &config) {
+  WriteRegister(config, kRegPwrMgmt0, kAccelGyroLowNoise);
+  // No register writes are allowed while the sensors start up.
+  delayMicroseconds(kPowerOnSettleUs);
+  WriteRegister(config, kRegSignalPathReset, kFifoFlush);
+}
+
+bool ImuSensorBegin(const void *ctx) {
+  const ImuSensorContext *config = GetImuContext(ctx);
+  if (config == nullptr || config->state == nullptr) {
+    return false;
+  }
+  SpiBusAttach(config->spi);
+
+  WriteRegister(*config, kRegDeviceConfig, kSoftReset);
+  delay(kResetSettleMs);
+  if (ReadRegister(*config, kRegWhoAmI) != kWhoAmI) {
+    return false;
+  }
+  WriteRegister(*config, kRegIntfConfig0, kIntfConfig0);
+  WriteRegister(*config, kRegGyroConfig0,
+                static_cast<uint8_t>(
+                    static_cast<uint8_t>(config->gyroRange) << 5 |
+                    static_cast<uint8_t>(config->odr)));
+  WriteRegister(*config, kRegAccelConfig0,
+                static_cast<uint8_t>(
+                    static_cast<uint8_t>(config->accelRange) << 5 |
+                    static_cast<uint8_t>(config->odr)));
+  if (config->useFifoInterrupt) {
+    WriteRegister(*config, kRegFifoConfig1,
+                  kFifoAccelGyro | kFifoWatermarkGreaterThan);
+    WriteRegister(*config, kRegFifoConfig2, kImuSamplesPerFrame);
+    WriteRegister(*config, kRegFifoConfig3, 0);
+    WriteRegister(*config, kRegIntConfig, kInt1PulsedPushPullHigh);
+    // The datasheet requires INT_ASYNC_RESET cleared for pulsed mode.
+    WriteRegister(*config, kRegIntConfig1, 0);
+    WriteRegister(*config, kRegIntSource0, kFifoThresholdInt1);
+    pinMode(config->intPin, INPUT);
+  } else {
+    WriteRegister(*config, kRegFifoConfig1, kFifoAccelGyro);
+  }
+  WriteRegister(*config, kRegFifoConfig, kFifoStream);
+  config->state->samples = 0;
+  PowerOn(*config);
+  return true;
+}
+
+// Header of a frame holding `count` samples, the first being sample number
+// `first`.
+void FinishFrame(CANFDMessage &frame, const uint16_t first,
+                 const uint8_t count, const bool backlog) {
+  frame.data[0] = first >> 8;
+  frame.data[1] = first & 0xFF;
+  frame.data[2] = count;
+  frame.data[3] = backlog ? kFlagBacklog : 0U;
+  frame.len = kHeaderFrame + count * kSampleBytes;
+  frame.pad();
+}
+}
+
+// One bus transaction: the FIFO count, then up to kImuSamplesPerPoll packets
+// in a single burst, with a yield in between so a pending CAN interrupt is
+// not held off for the whole burst. Sends nothing when the FIFO is empty.
+bool ImuSensorSampleBatch(const void *ctx, SensorFrameBatch &outFrames) {
+  const ImuSensorContext *config = GetImuContext(ctx);
+  if (config == nullptr || config->state == nullptr) {
+    return false;
+  }
+  ImuSensorState &state = *config->state;
+  SpiBusAcquire(config->spi);
+  SPI.transfer(kRegFifoCountH | kReadBit);
+  const uint16_t queued = static_cast<uint16_t>(SPI.transfer(0)) << 8 |
+                          SPI.transfer(0);
+
+  const uint8_t toRead =
+      queued < kImuSamplesPerPoll ? queued : kImuSamplesPerPoll;
+  uint8_t total = 0;
+  if (toRead > 0U) {
+    SpiBusYield(config->spi);
+    SPI.transfer(kRegFifoData | kReadBit);
+    CANFDMessage *frame = nullptr;
+    uint8_t inFrame = 0;
+    for (; total < toRead; ++total) {
+      uint8_t packet[kPacketBytes];
+      SPI.transfer(packet, kPacketBytes);
+      // Reads that race the FIFO past its last record come back empty.
+      if ((packet[0] & kHeaderEmpty) != 0U) {
+        break;
+      }
+      if (inFrame == kImuSamplesPerFrame) {
+        FinishFrame(*frame, state.samples, inFrame, true);
+        state.samples += inFrame;
+        inFrame = 0;
+      }
+      if (inFrame == 0U) {
+        frame = outFrames.add();
+      }
+      memcpy(&frame->data[kHeaderFrame + inFrame * kSampleBytes],
+             &packet[kPacketSensorOffset], kSampleBytes);
+      ++inFrame;
+    }
+    if (inFrame > 0U) {
+      FinishFrame(*frame, state.samples, inFrame, queued > total);
+      state.samples += inFrame;
+    }
+  }
+  SpiBusRelease(config->spi);
+  return total > 0U;
+}
+
+void ImuSensorSuspend(const void *ctx) {
+  const ImuSensorContext *config = GetImuContext(ctx);
+  if (config != nullptr) {
+    WriteRegister(*config, kRegPwrMgmt0, 0);
+  }
+}
+
+// The FIFO kept only what was queued before sleep; flush it so the first
+// frame after resume is current.
+void ImuSensorResume(const void *ctx) {
+  const ImuSensorContext *config = GetImuContext(ctx);
+  if (config != nullptr) {
+    PowerOn(*config);
+  }
+}
+
+void ImuSensorAttachDataReady(const void *ctx, void (*onReady)()) {
+  const ImuSensorContext *config = GetImuContext(ctx);
+  if (config == nullptr || !config->useFifoInterrupt) {
+    return;  // INT1 is only configured for the FIFO watermark.
+  }
+  attachInterrupt(digitalPinToInterrupt(config->intPin), onReady, RISING);
+}
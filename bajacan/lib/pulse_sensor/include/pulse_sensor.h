@@ -0,0 +1,66 @@
+// Period / frequency / RPM from a digital pulse train (hall-effect wheel or
+// CVT sensors, ignition pickups). Each sensor owns one TCB in input-capture
+// mode: its pin is routed through EVSYS to the TCB, every edge is timestamped
+// in hardware and the capture interrupt stores the timestamp in a small ring.
+// sample() averages the last edgesToAverage periods and sends a 12-byte frame,
+// big-endian:
+//   [0..3] period (us)  [4..7] frequency (0.01 Hz)  [8..9] RPM
+//   [10..11] edge counter (wraps)
+// All of period, frequency and RPM are 0 until two edges are seen and again
+// once no edge arrives for timeoutMs.
+//
+// Timers: the capture ISRs are only built for the timers in
+// BAJACAN_PULSE_TCB_MASK (bit n = TCBn). TCB0 belongs to analog_sensor's
+// Scan, Triggered and Windowed modes, DxCore's millis() normally runs on TCB2
+// and the AVR128DB32 has no TCB3, so the default is TCB1, which is free unless
+// the loop profiler is enabled. pulse_sensor.cpp fails to compile when the mask
+// names a timer the part lacks or that millis() or the profiler uses.
+
+#pragma once
+
+#include <config.h>
+
+#ifndef BAJACAN_PULSE_TCB_MASK
+#define BAJACAN_PULSE_TCB_MASK 0x02
+#endif
+
+// Edge timestamps kept per sensor; bounds edgesToAverage.
+constexpr uint8_t kPulseRingSize = 16;
+
+struct PulseSensorContext {
+  SensorContext base;
+  uint8_t pin;
+  uint8_t timer;  // TCB index; must be enabled in BAJACAN_PULSE_TCB_MASK.
+  // EVSYS channel that carries the pin to the timer. Channels come in pairs
+  // per two ports (0-1: PORTA/B, 2-3: PORTC/D, 4-5: PORTE/F, ...); channel 0
+  // is taken by analog_sensor's Triggered mode.
+  uint8_t eventChannel;
+  bool fallingEdge;        // Capture falling instead of rising edges.
+  uint8_t edgesToAverage;  // Periods averaged per report, 1 to ring size - 1.
+  uint16_t pulsesPerRev;   // Edges per revolution for RPM (teeth, magnets).
+  uint16_t timeoutMs;      // Report zero after this long without an edge.
+};
+
+constexpr bool PulseSensorSettingsValid(const PulseSensorContext &ctx) {
+  return ctx.timer < 4U && ((BAJACAN_PULSE_TCB_MASK >> ctx.timer) & 1U) != 0U &&
+         ctx.eventChannel < 10U && ctx.edgesToAverage >= 1U &&
+         ctx.edgesToAverage < kPulseRingSize && ctx.pulsesPerRev > 0U &&
+         ctx.timeoutMs > 0U;
+}
+
+bool PulseSensorBegin(const void *ctx);
+bool PulseSensorSample(const void *ctx, CANFDMessage &outFrame);
+void PulseSensorSuspend(const void *ctx);
+void PulseSensorResume(const void *ctx);
+
+constexpr SensorDescriptor MakePulseSensor(const PulseSensorContext *ctx) {
+  return SensorDescriptor{
+      .context = ctx,
+      .base = ctx != nullptr ? &ctx->base : nullptr,
+      .begin = PulseSensorBegin,
+      .sample = PulseSensorSample,
+      .suspend = PulseSensorSuspend,
+      .resume = PulseSensorResume,
+      .attachDataReady = nullptr,
+  };
+}
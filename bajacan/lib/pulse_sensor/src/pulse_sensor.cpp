@@ -0,0 +1,284 @@
+#include <Arduino.h>
+#include <loop_profiler.h>
+#include <pulse_sensor.h>
+
+namespace {
+const PulseSensorContext *GetPulseContext(const void *ctx) {
+  return static_cast<const PulseSensorContext *>(ctx);
+}
+
+// Timers count CLK_PER / 2; timestamps are that count extended to 32 bits by
+// the overflow interrupt, so they wrap after ~358 s at 24 MHz.
+constexpr uint32_t kTickHz = F_CPU / 2UL;
+constexpr uint32_t kTicksPerUs = kTickHz / 1000000UL;
+constexpr uint32_t kTicksPerMs = kTickHz / 1000UL;
+constexpr uint8_t kRingMask = kPulseRingSize - 1U;
+static_assert((kPulseRingSize & kRingMask) == 0U,
+              "Pulse ring size must be a power of two");
+constexpr uint8_t kFrameBytes = 12;
+constexpr uint8_t kEventGeneratorPortPin = 0x40;  // PORTx pin n: 0x40 + n
+constexpr uint8_t kEventGeneratorOddPort = 0x08;  // ...+ 8 for B, D, F.
+
+constexpr uint8_t SlotFor(const uint8_t timer) {
+  uint8_t slot = 0;
+  for (uint8_t i = 0; i < timer; ++i) {
+    slot += (BAJACAN_PULSE_TCB_MASK >> i) & 1U;
+  }
+  return slot;
+}
+
+constexpr uint8_t kSlotCount = SlotFor(4);
+static_assert(kSlotCount > 0U, "BAJACAN_PULSE_TCB_MASK enables no timer");
+static_assert((BAJACAN_PULSE_TCB_MASK & ~0x0F) == 0,
+              "BAJACAN_PULSE_TCB_MASK only covers TCB0..TCB3");
+
+// Reject timers this part lacks or that another module already drives.
+#ifndef TCB1
+static_assert((BAJACAN_PULSE_TCB_MASK & 0x02) == 0, "This part has no TCB1");
+#endif
+#ifndef TCB2
+static_assert((BAJACAN_PULSE_TCB_MASK & 0x04) == 0, "This part has no TCB2");
+#endif
+#ifndef TCB3
+static_assert((BAJACAN_PULSE_TCB_MASK & 0x08) == 0, "This part has no TCB3");
+#endif
+static_assert((BAJACAN_PULSE_TCB_MASK & 0x01) == 0,
+              "TCB0 belongs to analog_sensor's Triggered and Windowed modes");
+#if BAJACAN_ENABLE_LOOP_PROFILER
+static_assert(((BAJACAN_PULSE_TCB_MASK >> BAJACAN_PROFILER_TCB_INDEX) & 1) == 0,
+              "The loop profiler's TCB is in BAJACAN_PULSE_TCB_MASK");
+#endif
+#if defined(MILLIS_USE_TIMERB0) || defined(MILLIS_USE_TIMERB1) || \
+    defined(MILLIS_USE_TIMERB2) || defined(MILLIS_USE_TIMERB3)
+constexpr uint8_t kMillisTimerBit =
+#if defined(MILLIS_USE_TIMERB0)
+    0x01;
+#elif defined(MILLIS_USE_TIMERB1)
+    0x02;
+#elif defined(MILLIS_USE_TIMERB2)
+    0x04;
+#else
+    0x08;
+#endif
+static_assert((BAJACAN_PULSE_TCB_MASK & kMillisTimerBit) == 0,
+              "millis() runs on a TCB in BAJACAN_PULSE_TCB_MASK");
+#endif
+
+// Written by the capture ISR; everything sample() reads is copied with
+// interrupts masked.
+struct PulseChannel {
+  volatile uint32_t edges[kPulseRingSize];
+  volatile uint16_t edgeCount;  // Total edges, wraps; head = edgeCount & mask.
+  volatile uint8_t stored;      // Valid ring entries, saturating.
+  volatile uint16_t overflows;
+};
+
+PulseChannel gChannels[kSlotCount];
+
+// Only called for timers in the mask, which the asserts above limit to timers
+// this part has; the TCB0 default is never reached.
+TCB_t &TimerFor(const uint8_t timer) {
+  switch (timer) {
+#ifdef TCB1
+    case 1:
+      return TCB1;
+#endif
+#ifdef TCB2
+    case 2:
+      return TCB2;
+#endif
+#ifdef TCB3
+    case 3:
+      return TCB3;
+#endif
+    default:
+      return TCB0;
+  }
+}
+
+volatile uint8_t &CaptureUserFor(const uint8_t timer) {
+  switch (timer) {
+#ifdef TCB1
+    case 1:
+      return EVSYS.USERTCB1CAPT;
+#endif
+#ifdef TCB2
+    case 2:
+      return EVSYS.USERTCB2CAPT;
+#endif
+#ifdef TCB3
+    case 3:
+      return EVSYS.USERTCB3CAPT;
+#endif
+    default:
+      return EVSYS.USERTCB0CAPT;
+  }
+}
+
+// Pin-event generator for `pin` on `channel`, or 0 if that channel cannot see
+// the pin's port.
+uint8_t EventGeneratorFor(const uint8_t pin, const uint8_t channel) {
+  const uint8_t port = digitalPinToPort(pin);
+  if (port == NOT_A_PORT || port / 2U != channel / 2U) {
+    return 0;
+  }
+  return kEventGeneratorPortPin + (port % 2U) * kEventGeneratorOddPort +
+         digitalPinToBitPosition(pin);
+}
+
+// Bounded work per interrupt: one capture and/or one overflow.
+void OnTimerInterrupt(const uint8_t timer) {
+  TCB_t &tcb = TimerFor(timer);
+  PulseChannel &channel = gChannels[SlotFor(timer)];
+  const uint8_t flags = tcb.INTFLAGS;
+  if ((flags & TCB_CAPT_bm) != 0U) {
+    const uint16_t captured = tcb.CCMP;  // Clears CAPT.
+    uint16_t high = channel.overflows;
+    // An overflow still pending with a small capture happened before the edge.
+    if ((flags & TCB_OVF_bm) != 0U && captured < 0x8000U) {
+      ++high;
+    }
+    const uint16_t count = channel.edgeCount;
+    channel.edges[count & kRingMask] =
+        (static_cast<uint32_t>(high) << 16) | captured;
+    channel.edgeCount = count + 1U;
+    if (channel.stored < kPulseRingSize) {
+      channel.stored = channel.stored + 1U;
+    }
+  }
+  if ((flags & TCB_OVF_bm) != 0U) {
+    tcb.INTFLAGS = TCB_OVF_bm;
+    channel.overflows = channel.overflows + 1U;
+  }
+}
+
+// Current extended timestamp; call with interrupts masked.
+uint32_t NowTicks(const uint8_t timer) {
+  TCB_t &tcb = TimerFor(timer);
+  const uint16_t low = tcb.CNT;
+  uint16_t high = gChannels[SlotFor(timer)].overflows;
+  if ((tcb.INTFLAGS & TCB_OVF_bm) != 0U && low < 0x8000U) {
+    ++high;
+  }
+  return (static_cast<uint32_t>(high) << 16) | low;
+}
+
+void Put16(CANFDMessage &frame, const uint8_t at, const uint16_t value) {
+  frame.data[at] = value >> 8;
+  frame.data[at + 1] = value & 0xFF;
+}
+
+void Put32(CANFDMessage &frame, const uint8_t at, const uint32_t value) {
+  Put16(frame, at, static_cast<uint16_t>(value >> 16));
+  Put16(frame, at + 2, static_cast<uint16_t>(value & 0xFFFF));
+}
+}
+
+#if (BAJACAN_PULSE_TCB_MASK & 0x02) && defined(TCB1)
+ISR(TCB1_INT_vect) { OnTimerInterrupt(1); }
+#endif
+#if (BAJACAN_PULSE_TCB_MASK & 0x04) && defined(TCB2)
+ISR(TCB2_INT_vect) { OnTimerInterrupt(2); }
+#endif
+#if (BAJACAN_PULSE_TCB_MASK & 0x08) && defined(TCB3)
+ISR(TCB3_INT_vect) { OnTimerInterrupt(3); }
+#endif
+
+bool PulseSensorBegin(const void *ctx) {
+  const PulseSensorContext *config = GetPulseContext(ctx);
+  if (config == nullptr || !PulseSensorSettingsValid(*config)) {
+    return false;
+  }
+  const uint8_t generator =
+      EventGeneratorFor(config->pin, config->eventChannel);
+  if (generator == 0U) {
+    return false;
+  }
+  pinMode(config->pin, INPUT);
+
+  TCB_t &tcb = TimerFor(config->timer);
+  tcb.CTRLA = 0;
+  tcb.CTRLB = TCB_CNTMODE_CAPT_gc;
+  tcb.EVCTRL = TCB_CAPTEI_bm | TCB_FILTER_bm |
+               (config->fallingEdge ? TCB_EDGE_bm : 0U);
+  tcb.CNT = 0;
+  tcb.INTFLAGS = TCB_CAPT_bm | TCB_OVF_bm;
+  tcb.INTCTRL = TCB_CAPT_bm | TCB_OVF_bm;
+
+  PulseChannel &channel = gChannels[SlotFor(config->timer)];
+  channel.edgeCount = 0;
+  channel.stored = 0;
+  channel.overflows = 0;
+  (&EVSYS.CHANNEL0)[config->eventChannel] = generator;
+  CaptureUserFor(config->timer) = config->eventChannel + 1U;
+  tcb.CTRLA = TCB_CLKSEL_DIV2_gc | TCB_ENABLE_bm;
+  return true;
+}
+
+bool PulseSensorSample(const void *ctx, CANFDMessage &outFrame) {
+  const PulseSensorContext *config = GetPulseContext(ctx);
+  if (config == nullptr) {
+    return false;
+  }
+  PulseChannel &channel = gChannels[SlotFor(config->timer)];
+  uint8_t sreg = SREG;
+  noInterrupts();
+  const uint16_t count = channel.edgeCount;
+  const uint8_t stored = channel.stored;
+  const uint8_t periods =
+      stored > config->edgesToAverage ? config->edgesToAverage
+                                      : (stored > 0U ? stored - 1U : 0U);
+  const uint32_t last = channel.edges[(count - 1U) & kRingMask];
+  const uint32_t first = channel.edges[(count - 1U - periods) & kRingMask];
+  const uint32_t now = NowTicks(config->timer);
+  SREG = sreg;
+
+  uint32_t periodTicks = 0;
+  if (now - last < static_cast<uint32_t>(config->timeoutMs) * kTicksPerMs) {
+    if (periods > 0U) {
+      periodTicks = (last - first) / periods;
+    }
+  } else if (stored > 0U) {
+    // Timed out: drop the old edges, or once the tick count wraps (2^32
+    // ticks) `now - last` would look recent again and they would be reused.
+    // An edge that arrived since the snapshot is kept.
+    sreg = SREG;
+    noInterrupts();
+    if (channel.edgeCount == count) {
+      channel.stored = 0;
+    }
+    SREG = sreg;
+  }
+  uint32_t centiHz = 0;
+  uint32_t rpm = 0;
+  if (periodTicks > 0U) {
+    centiHz = kTickHz * 100UL / periodTicks;
+    rpm = kTickHz * 60UL / config->pulsesPerRev / periodTicks;
+  }
+  Put32(outFrame, 0, periodTicks / kTicksPerUs);
+  Put32(outFrame, 4, centiHz);
+  Put16(outFrame, 8, rpm > UINT16_MAX ? UINT16_MAX : rpm);
+  Put16(outFrame, 10, count);
+  outFrame.len = kFrameBytes;
+  return true;
+}
+
+void PulseSensorSuspend(const void *ctx) {
+  const PulseSensorContext *config = GetPulseContext(ctx);
+  if (config != nullptr) {
+    TimerFor(config->timer).CTRLA = 0;
+  }
+}
+
+// Edges from before sleep would fake one very long period; start over.
+void PulseSensorResume(const void *ctx) {
+  const PulseSensorContext *config = GetPulseContext(ctx);
+  if (config == nullptr) {
+    return;
+  }
+  PulseChannel &channel = gChannels[SlotFor(config->timer)];
+  noInterrupts();
+  channel.stored = 0;
+  interrupts();
+  TimerFor(config->timer).CTRLA = TCB_CLKSEL_DIV2_gc | TCB_ENABLE_bm;
+}
@@ -0,0 +1,250 @@
+// Header-only fixed-point filters. Every filter takes and returns int16_t
+// samples through update(), keeps its state in a few integers and never
+// touches floating point at runtime; coefficients are computed at compile time
+// with constexpr_math.h. Nothing here depends on Arduino, so the filters build
+// and are benchmarked on the host (test/test_sensor_filter).
+
+#pragma once
+
+#include <constexpr_math.h>
+#include <stdint.h>
+
+// Boxcar average over the last N samples. The window is primed with the first
+// sample, so the output is valid from the first call.
+template <uint8_t N>
+class MovingAverageFilter {
+  static_assert(N > 0U, "Moving average needs at least one sample");
+
+ public:
+  int16_t update(const int16_t x) {
+    if (!primed_) {
+      for (uint8_t i = 0; i < N; ++i) {
+        window_[i] = x;
+      }
+      sum_ = static_cast<int32_t>(x) * N;
+      primed_ = true;
+    }
+    sum_ += static_cast<int32_t>(x) - window_[next_];
+    window_[next_] = x;
+    next_ = next_ + 1U == N ? 0 : next_ + 1U;
+    return static_cast<int16_t>(sum_ / N);
+  }
+
+  void reset() { primed_ = false; }
+
+ private:
+  int16_t window_[N] = {};
+  int32_t sum_ = 0;
+  uint8_t next_ = 0;
+  bool primed_ = false;
+};
+
+// Shift count whose alpha = 2^-shift best matches a first-order low-pass with
+// the given cutoff at the given sample rate.
+constexpr uint8_t EmaShiftFor(const double cutoffHz, const double sampleHz) {
+  const double alpha = 1 - CxExp(-2 * kCxPi * cutoffHz / sampleHz);
+  const int32_t shift = CxRound(-CxLog(alpha) / kCxLn2);
+  return shift < 0 ? 0 : (shift > 15 ? 15 : static_cast<uint8_t>(shift));
+}
+
+// Exponential moving average with alpha = 2^-kShift: one add, one subtract and
+// two shifts per sample. The state keeps kShift fraction bits so small steps
+// are not lost to truncation.
+template <uint8_t kShift>
+class ExponentialFilter {
+  static_assert(kShift <= 15U, "Exponential filter shift must be 0-15");
+
+ public:
+  int16_t update(const int16_t x) {
+    if (!primed_) {
+      state_ = static_cast<int32_t>(x) << kShift;
+      primed_ = true;
+    }
+    state_ += static_cast<int32_t>(x) - Output();
+    return Output();
+  }
+
+  void reset() { primed_ = false; }
+
+ private:
+  int16_t Output() const {
+    return static_cast<int16_t>((state_ + kHalf) >> kShift);
+  }
+
+  static constexpr int32_t kHalf = kShift > 0U ? (1L << (kShift - 1U)) : 0;
+  int32_t state_ = 0;
+  bool primed_ = false;
+};
+
+// Biquad coefficients in Q14, a0 normalised to 1 and a1/a2 stored with the
+// sign used in y = b0 x0 + b1 x1 + b2 x2 - a1 y1 - a2 y2.
+struct BiquadCoefficients {
+  int16_t b0, b1, b2, a1, a2;
+};
+
+constexpr uint8_t kBiquadFractionBits = 14;
+// update() clamps inputs to this magnitude (any ADC reading of 14 bits or
+// less passes untouched), which keeps the feed-forward terms under 2^30. The
+// feedback terms add at most 3 * 2^14 * |y|, so the 32-bit accumulator cannot
+// overflow while outputs stay within about +-21800; a high-pass fed a
+// full-scale step, or a high-Q peak, can go past that.
+constexpr int16_t kBiquadMaxInput = 16383;
+
+namespace sensor_filter_detail {
+constexpr int32_t ToQ14(const double value) {
+  return CxRound(value * (1L << kBiquadFractionBits));
+}
+
+constexpr bool FitsQ14(const int32_t value) {
+  return value >= INT16_MIN && value <= INT16_MAX;
+}
+
+// Coefficients before narrowing to int16, so BiquadDesignValid() can see the
+// ones that do not fit (a1 reaches +2.0, i.e. 32768, near Nyquist).
+struct WideBiquadCoefficients {
+  int32_t b0, b1, b2, a1, a2;
+};
+
+// RBJ audio-EQ-cookbook designs; `highPass` picks the numerator.
+constexpr WideBiquadCoefficients WideBiquad(const double cutoffHz,
+                                            const double sampleHz,
+                                            const double q,
+                                            const bool highPass) {
+  const double w0 = 2 * kCxPi * cutoffHz / sampleHz;
+  const double cosW0 = CxCos(w0);
+  const double alpha = CxSin(w0) / (2 * q);
+  const double a0 = 1 + alpha;
+  const int32_t a1 = ToQ14(-2 * cosW0 / a0);
+  const int32_t a2 = ToQ14((1 - alpha) / a0);
+  if (highPass) {
+    const int32_t b0 = ToQ14((1 + cosW0) / 2 / a0);
+    return WideBiquadCoefficients{b0, -2 * b0, b0, a1, a2};
+  }
+  // Derive the numerator from the rounded poles so DC gain stays exactly 1;
+  // at low cutoffs rounding b on its own loses a few percent.
+  const int32_t sum = (1L << kBiquadFractionBits) + a1 + a2;
+  const int32_t b0 = sum / 4;
+  return WideBiquadCoefficients{b0, sum - 2 * b0, b0, a1, a2};
+}
+
+constexpr BiquadCoefficients Narrow(const WideBiquadCoefficients &c) {
+  return BiquadCoefficients{
+      static_cast<int16_t>(c.b0), static_cast<int16_t>(c.b1),
+      static_cast<int16_t>(c.b2), static_cast<int16_t>(c.a1),
+      static_cast<int16_t>(c.a2)};
+}
+}  // namespace sensor_filter_detail
+
+// True when the design is realisable in Q14: 0 < cutoffHz < sampleHz / 2,
+// q > 0 and every coefficient fits int16. The design functions below narrow
+// without checking, so static_assert this for each filter a board uses.
+constexpr bool BiquadDesignValid(const double cutoffHz, const double sampleHz,
+                                 const double q = 0.7071,
+                                 const bool highPass = false) {
+  if (!(cutoffHz > 0 && cutoffHz < sampleHz / 2 && q > 0)) {
+    return false;
+  }
+  const sensor_filter_detail::WideBiquadCoefficients c =
+      sensor_filter_detail::WideBiquad(cutoffHz, sampleHz, q, highPass);
+  return sensor_filter_detail::FitsQ14(c.b0) &&
+         sensor_filter_detail::FitsQ14(c.b1) &&
+         sensor_filter_detail::FitsQ14(c.b2) &&
+         sensor_filter_detail::FitsQ14(c.a1) &&
+         sensor_filter_detail::FitsQ14(c.a2);
+}
+
+constexpr BiquadCoefficients BiquadLowPass(const double cutoffHz,
+                                           const double sampleHz,
+                                           const double q = 0.7071) {
+  return sensor_filter_detail::Narrow(
+      sensor_filter_detail::WideBiquad(cutoffHz, sampleHz, q, false));
+}
+
+constexpr BiquadCoefficients BiquadHighPass(const double cutoffHz,
+                                            const double sampleHz,
+                                            const double q = 0.7071) {
+  return sensor_filter_detail::Narrow(
+      sensor_filter_detail::WideBiquad(cutoffHz, sampleHz, q, true));
+}
+
+// Direct form I biquad with 16x16->32 multiplies. The bits shifted off each
+// output are fed back into the next one (first-order error shaping), which
+// keeps low cutoffs stable despite the coarse Q14 coefficients.
+class BiquadFilter {
+ public:
+  explicit constexpr BiquadFilter(const BiquadCoefficients &coefficients)
+      : c_(coefficients) {}
+
+  int16_t update(int16_t x) {
+    if (x > kBiquadMaxInput) {
+      x = kBiquadMaxInput;
+    } else if (x < -kBiquadMaxInput) {
+      x = -kBiquadMaxInput;
+    }
+    int32_t acc = error_;
+    acc += static_cast<int32_t>(c_.b0) * x;
+    acc += static_cast<int32_t>(c_.b1) * x1_;
+    acc += static_cast<int32_t>(c_.b2) * x2_;
+    acc -= static_cast<int32_t>(c_.a1) * y1_;
+    acc -= static_cast<int32_t>(c_.a2) * y2_;
+    int32_t y = acc >> kBiquadFractionBits;
+    error_ = acc - (y << kBiquadFractionBits);
+    if (y > INT16_MAX) {
+      y = INT16_MAX;
+    } else if (y < INT16_MIN) {
+      y = INT16_MIN;
+    }
+    x2_ = x1_;
+    x1_ = x;
+    y2_ = y1_;
+    y1_ = static_cast<int16_t>(y);
+    return y1_;
+  }
+
+  void reset() {
+    x1_ = x2_ = y1_ = y2_ = 0;
+    error_ = 0;
+  }
+
+ private:
+  BiquadCoefficients c_;
+  int16_t x1_ = 0, x2_ = 0, y1_ = 0, y2_ = 0;
+  int32_t error_ = 0;
+};
+
+// Median of the last N samples (N odd). Rejects isolated spikes that would
+// drag an average; costs an N-element insertion sort per sample.
+template <uint8_t N>
+class MedianFilter {
+  static_assert(N % 2U == 1U && N <= 15U, "Median window must be odd, <= 15");
+
+ public:
+  int16_t update(const int16_t x) {
+    if (!primed_) {
+      for (uint8_t i = 0; i < N; ++i) {
+        window_[i] = x;
+      }
+      primed_ = true;
+    }
+    window_[next_] = x;
+    next_ = next_ + 1U == N ? 0 : next_ + 1U;
+
+    int16_t sorted[N];
+    for (uint8_t i = 0; i < N; ++i) {
+      const int16_t value = window_[i];
+      uint8_t j = i;
+      for (; j > 0 && sorted[j - 1] > value; --j) {
+        sorted[j] = sorted[j - 1];
+      }
+      sorted[j] = value;
+    }
+    return sorted[N / 2];
+  }
+
+  void reset() { primed_ = false; }
+
+ private:
+  int16_t window_[N] = {};
+  uint8_t next_ = 0;
+  bool primed_ = false;
+};
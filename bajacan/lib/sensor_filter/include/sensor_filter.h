@@ -0,0 +1,138 @@
+// Header-only fixed-point filters for sensor streams; the filters themselves
+// are in fixed_point_filter.h.
+//
+// FilteredSensor wraps any SensorDescriptor that has a sample() hook: each
+// poll samples the source, runs one 16-bit field of its frame through a filter
+// and sends every `decimation`-th filtered value, so a board can sample fast
+// and transmit slowly. begin() rejects two-phase and batch-only sources.
+
+#pragma once
+
+#include <config.h>
+#include <fixed_point_filter.h>
+#include <stdint.h>
+
+// Mutable part of a FilteredSensor; define one per sensor in RAM.
+template <typename Filter>
+struct FilteredSensorState {
+  Filter filter;
+  uint8_t polls;
+};
+
+template <typename Filter>
+struct FilteredSensorContext {
+  SensorContext base;  // ID and rate of the filtered stream.
+  // Raw sensor sampled on every poll. Its own base is ignored; keep it out of
+  // the board's sensor table.
+  const SensorDescriptor *source;
+  uint8_t fieldOffset;  // Big-endian int16 field of the source frame.
+  uint8_t decimation;   // Send every Nth filtered value (0 or 1: all).
+  FilteredSensorState<Filter> *state;
+};
+
+namespace sensor_filter_detail {
+template <typename Filter>
+const FilteredSensorContext<Filter> *GetFilteredContext(const void *ctx) {
+  return static_cast<const FilteredSensorContext<Filter> *>(ctx);
+}
+}  // namespace sensor_filter_detail
+
+template <typename Filter>
+bool FilteredSensorBegin(const void *ctx) {
+  const auto *config = sensor_filter_detail::GetFilteredContext<Filter>(ctx);
+  // Only single-frame sources can be wrapped: a two-phase (startConversion /
+  // collect) or batch-only source has no sample() to call.
+  if (config == nullptr || config->source == nullptr ||
+      config->source->sample == nullptr || config->state == nullptr) {
+    return false;
+  }
+  config->state->filter.reset();
+  config->state->polls = 0;
+  const SensorDescriptor &source = *config->source;
+  return source.begin == nullptr || source.begin(source.context);
+}
+
+// Returns false (nothing to send) on the polls dropped by decimation.
+template <typename Filter>
+bool FilteredSensorSample(const void *ctx, CANFDMessage &outFrame) {
+  const auto *config = sensor_filter_detail::GetFilteredContext<Filter>(ctx);
+  if (config == nullptr || config->source == nullptr ||
+      config->source->sample == nullptr) {
+    return false;
+  }
+  const SensorDescriptor &source = *config->source;
+  if (!source.sample(source.context, outFrame) ||
+      outFrame.len < config->fieldOffset + 2U) {
+    return false;
+  }
+  const int16_t raw = static_cast<int16_t>(
+      (static_cast<uint16_t>(outFrame.data[config->fieldOffset]) << 8) |
+      outFrame.data[config->fieldOffset + 1]);
+  FilteredSensorState<Filter> &state = *config->state;
+  const int16_t filtered = state.filter.update(raw);
+  if (++state.polls < config->decimation) {
+    return false;
+  }
+  state.polls = 0;
+  outFrame.len = 2;
+  outFrame.data[0] = static_cast<uint16_t>(filtered) >> 8;
+  outFrame.data[1] = static_cast<uint16_t>(filtered) & 0xFF;
+  return true;
+}
+
+template <typename Filter>
+void FilteredSensorSuspend(const void *ctx) {
+  const auto *config = sensor_filter_detail::GetFilteredContext<Filter>(ctx);
+  if (config == nullptr || config->source == nullptr) {
+    return;
+  }
+  const SensorDescriptor &source = *config->source;
+  if (source.suspend != nullptr) {
+    source.suspend(source.context);
+  }
+}
+
+// History from before sleep says nothing about the signal now.
+template <typename Filter>
+void FilteredSensorResume(const void *ctx) {
+  const auto *config = sensor_filter_detail::GetFilteredContext<Filter>(ctx);
+  if (config == nullptr || config->source == nullptr ||
+      config->state == nullptr) {
+    return;
+  }
+  config->state->filter.reset();
+  config->state->polls = 0;
+  const SensorDescriptor &source = *config->source;
+  if (source.resume != nullptr) {
+    source.resume(source.context);
+  }
+}
+
+template <typename Filter>
+void FilteredSensorAttachDataReady(const void *ctx, void (*onReady)()) {
+  const auto *config = sensor_filter_detail::GetFilteredContext<Filter>(ctx);
+  if (config == nullptr || config->source == nullptr ||
+      config->source->attachDataReady == nullptr) {
+    return;
+  }
+  const SensorDescriptor &source = *config->source;
+  source.attachDataReady(source.context, onReady);
+}
+
+template <typename Filter>
+constexpr SensorDescriptor MakeFilteredSensor(
+    const FilteredSensorContext<Filter> *ctx) {
+  return SensorDescriptor{
+      .context = ctx,
+      .base = ctx != nullptr ? &ctx->base : nullptr,
+      .begin = FilteredSensorBegin<Filter>,
+      .sample = FilteredSensorSample<Filter>,
+      .suspend = FilteredSensorSuspend<Filter>,
+      .resume = FilteredSensorResume<Filter>,
+      .attachDataReady =
+          ctx != nullptr && ctx->source != nullptr &&
+                  ctx->source->attachDataReady != nullptr
+              ? FilteredSensorAttachDataReady<Filter>
+              : nullptr,
+  };
+}
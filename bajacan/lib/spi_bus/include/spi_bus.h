@@ -0,0 +1,43 @@
+// Arbiter for the SPI bus shared by the MCP251863 and SPI sensors. Sensor
+// libraries wrap every chip-select frame in SpiBusAcquire/SpiBusRelease; the
+// bus applies the device's clock and mode and drives its chip select.
+//
+// Interrupt handlers that need the bus (the CAN controller's) must not run
+// while a sensor holds it. They check SpiBusBusy(), mask their own interrupt
+// source and hand SpiBusDefer() a callback that re-enables it; deferred
+// callbacks run, highest priority first, when the holder releases the bus or
+// reaches a SpiBusYield() point between frames.
+
+#pragma once
+
+#include <stdint.h>
+
+constexpr uint8_t kSpiBusMaxDeferred = 4;
+
+enum class SpiPriority : uint8_t { Low, Normal, High };
+
+struct SpiDevice {
+  uint8_t csPin;
+  uint32_t clockHz;
+  uint8_t dataMode;  // SPI_MODE0..SPI_MODE3.
+  // Deferred work of a higher priority may run at this device's yield points.
+  SpiPriority priority;
+};
+
+// Drives the chip select high (idle). Call from each device's begin() before
+// the first transfer; a floating chip select garbles everyone else's traffic.
+void SpiBusAttach(const SpiDevice &device);
+
+// Main-loop only. Applies the device's settings and asserts its chip select.
+void SpiBusAcquire(const SpiDevice &device);
+// Deasserts the chip select and runs any work deferred meanwhile.
+void SpiBusRelease(const SpiDevice &device);
+// Between two frames of one holder: releases the chip select, runs deferred
+// work that outranks the holder, then reacquires.
+void SpiBusYield(const SpiDevice &device);
+
+// ISR-safe.
+bool SpiBusBusy();
+// Queues `resume` (once) to run in the main loop when the bus frees up.
+// Returns false when the queue is full.
+bool SpiBusDefer(SpiPriority priority, void (*resume)());
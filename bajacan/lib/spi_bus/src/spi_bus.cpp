@@ -0,0 +1,96 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <spi_bus.h>
+
+namespace {
+struct Deferred {
+  void (*resume)();
+  SpiPriority priority;
+};
+
+// Written by ISRs; read and drained with interrupts masked.
+volatile bool gBusy = false;
+Deferred gDeferred[kSpiBusMaxDeferred];
+volatile uint8_t gDeferredCount = 0;
+
+SPISettings SettingsFor(const SpiDevice &device) {
+  return SPISettings(device.clockHz, MSBFIRST, device.dataMode);
+}
+
+// Runs queued callbacks that outrank `floor`, highest priority first. Each is
+// removed before it runs, so it may defer itself again.
+void RunDeferred(const SpiPriority floor, const bool inclusive) {
+  while (true) {
+    void (*resume)() = nullptr;
+    noInterrupts();
+    uint8_t best = kSpiBusMaxDeferred;
+    for (uint8_t i = 0; i < gDeferredCount; ++i) {
+      const SpiPriority priority = gDeferred[i].priority;
+      if ((priority > floor || (inclusive && priority == floor)) &&
+          (best == kSpiBusMaxDeferred ||
+           priority > gDeferred[best].priority)) {
+        best = i;
+      }
+    }
+    if (best != kSpiBusMaxDeferred) {
+      resume = gDeferred[best].resume;
+      gDeferredCount = gDeferredCount - 1U;
+      gDeferred[best] = gDeferred[gDeferredCount];
+    }
+    interrupts();
+    if (resume == nullptr) {
+      return;
+    }
+    resume();
+  }
+}
+}
+
+void SpiBusAttach(const SpiDevice &device) {
+  digitalWrite(device.csPin, HIGH);
+  pinMode(device.csPin, OUTPUT);
+}
+
+void SpiBusAcquire(const SpiDevice &device) {
+  // Set before beginTransaction so an ISR arriving in between defers.
+  gBusy = true;
+  SPI.beginTransaction(SettingsFor(device));
+  digitalWrite(device.csPin, LOW);
+}
+
+void SpiBusRelease(const SpiDevice &device) {
+  digitalWrite(device.csPin, HIGH);
+  SPI.endTransaction();
+  gBusy = false;
+  RunDeferred(SpiPriority::Low, true);
+}
+
+void SpiBusYield(const SpiDevice &device) {
+  digitalWrite(device.csPin, HIGH);
+  if (gDeferredCount != 0U) {
+    SPI.endTransaction();
+    gBusy = false;
+    RunDeferred(device.priority, false);
+    gBusy = true;
+    SPI.beginTransaction(SettingsFor(device));
+  }
+  digitalWrite(device.csPin, LOW);
+}
+
+bool SpiBusBusy() { return gBusy; }
+
+bool SpiBusDefer(const SpiPriority priority, void (*resume)()) {
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  bool queued = false;
+  for (uint8_t i = 0; i < gDeferredCount && !queued; ++i) {
+    queued = gDeferred[i].resume == resume;
+  }
+  if (!queued && gDeferredCount < kSpiBusMaxDeferred) {
+    gDeferred[gDeferredCount] = Deferred{resume, priority};
+    gDeferredCount = gDeferredCount + 1U;
+    queued = true;
+  }
+  SREG = sreg;
+  return queued;
+}
@@ -0,0 +1,78 @@
+#include <boot_report.h>
+
+uint8_t BootCaptureResetFlags() {
+  // DxCore's init_reset_flags() (or Optiboot, when used) has already read and
+  // cleared RSTFR before setup() and left the flags in GPIOR0. RSTFR is still
+  // read in case a core build skipped that step.
+  const uint8_t pending = RSTCTRL.RSTFR;
+  RSTCTRL.RSTFR = pending;  // Flags are cleared by writing ones.
+  const uint8_t flags = GPIOR0 | pending;
+  GPIOR0 = 0;
+  return flags;
+}
+
+#if BAJACAN_ENABLE_BOOT_REPORT
+namespace {
+
+constexpr uint8_t kPhaseCount = static_cast<uint8_t>(BootPhase::Count);
+constexpr uint8_t kHeaderBytes = 2;
+constexpr uint8_t kReportBytes = 24;
+static_assert(kHeaderBytes + kPhaseCount * 4U <= kReportBytes,
+              "Boot report must fit a valid CAN FD length");
+
+uint32_t gPhaseUs[kPhaseCount];
+uint8_t gMarkedPhases;  // Bit n set once phase n is recorded.
+uint8_t gResetFlags;
+bool gSkippedSelfTest;
+bool gSent;
+uint32_t gReportId;
+bool gUseExtendedIds;
+
+uint8_t Put16(CANFDMessage &frame, uint8_t at, const uint16_t value) {
+  frame.data[at++] = value >> 8;
+  frame.data[at++] = value & 0xFF;
+  return at;
+}
+
+}  // namespace
+
+void BootReportBegin(const uint8_t resetFlags, const bool skippedSelfTest,
+                     const uint32_t reportId, const bool useExtendedIds) {
+  gResetFlags = resetFlags;
+  gSkippedSelfTest = skippedSelfTest;
+  gReportId = reportId;
+  gUseExtendedIds = useExtendedIds;
+}
+
+void BootReportMark(const BootPhase phase) {
+  const uint8_t bit = 1U << static_cast<uint8_t>(phase);
+  if ((gMarkedPhases & bit) != 0U) {
+    return;
+  }
+  gPhaseUs[static_cast<uint8_t>(phase)] = micros();
+  gMarkedPhases |= bit;
+}
+
+bool BootReportPending() {
+  const uint8_t firstFrame = 1U << static_cast<uint8_t>(BootPhase::FirstFrame);
+  return !gSent && (gMarkedPhases & firstFrame) != 0U;
+}
+
+void BootReportBuild(CANFDMessage &outFrame) {
+  outFrame.id = gReportId;
+  outFrame.ext = gUseExtendedIds;
+  outFrame.len = kReportBytes;
+  outFrame.data[0] = gResetFlags;
+  outFrame.data[1] = gSkippedSelfTest ? 1U : 0U;
+  uint8_t at = kHeaderBytes;
+  for (uint8_t i = 0; i < kPhaseCount; ++i) {
+    at = Put16(outFrame, at, static_cast<uint16_t>(gPhaseUs[i] >> 16));
+    at = Put16(outFrame, at, static_cast<uint16_t>(gPhaseUs[i] & 0xFFFF));
+  }
+  while (at < kReportBytes) {
+    outFrame.data[at++] = 0;
+  }
+}
+
+void BootReportSent() { gSent = true; }
+#endif
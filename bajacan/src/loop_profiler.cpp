@@ -0,0 +1,97 @@
+#include <loop_profiler.h>
+
+#if BAJACAN_ENABLE_LOOP_PROFILER
+namespace {
+
+constexpr uint8_t kPhaseCount = static_cast<uint8_t>(LoopPhase::Count);
+constexpr uint8_t kRecordBytes = 10;
+constexpr uint8_t kReportBytes = 64;
+static_assert(kPhaseCount * kRecordBytes <= kReportBytes,
+              "Profiler report must match a valid CAN FD length");
+
+struct PhaseStats {
+  uint32_t totalCycles;
+  uint32_t worstCycles;
+  uint16_t calls;
+};
+
+PhaseStats gPhases[kPhaseCount];
+// Upper half of the cycle count, advanced by the TCB's wrap interrupt.
+volatile uint16_t gWraps = 0;
+uint32_t gReportId = 0;
+bool gUseExtendedIds = false;
+
+uint8_t Put16(CANFDMessage &frame, uint8_t at, const uint16_t value) {
+  frame.data[at++] = value >> 8;
+  frame.data[at++] = value & 0xFF;
+  return at;
+}
+
+uint8_t Put32(CANFDMessage &frame, uint8_t at, const uint32_t value) {
+  at = Put16(frame, at, static_cast<uint16_t>(value >> 16));
+  return Put16(frame, at, static_cast<uint16_t>(value & 0xFFFF));
+}
+
+}  // namespace
+
+ISR(BAJACAN_PROFILER_TCB_VECT) {
+  BAJACAN_PROFILER_TCB.INTFLAGS = TCB_CAPT_bm;
+  gWraps = gWraps + 1U;
+}
+
+void LoopProfilerBegin(const uint32_t reportId, const bool useExtendedIds) {
+  gReportId = reportId;
+  gUseExtendedIds = useExtendedIds;
+  BAJACAN_PROFILER_TCB.CTRLA = 0;
+  BAJACAN_PROFILER_TCB.CTRLB = TCB_CNTMODE_INT_gc;  // Periodic, wraps at CCMP.
+  BAJACAN_PROFILER_TCB.CCMP = 0xFFFF;
+  BAJACAN_PROFILER_TCB.CNT = 0;
+  BAJACAN_PROFILER_TCB.INTFLAGS = TCB_CAPT_bm;
+  BAJACAN_PROFILER_TCB.INTCTRL = TCB_CAPT_bm;
+  BAJACAN_PROFILER_TCB.CTRLA = TCB_CLKSEL_DIV1_gc | TCB_ENABLE_bm;
+}
+
+uint32_t LoopProfilerNow() {
+  const uint8_t sreg = SREG;
+  noInterrupts();
+  const uint16_t low = BAJACAN_PROFILER_TCB.CNT;
+  uint16_t high = gWraps;
+  // A wrap still pending with a small count happened before the read.
+  if ((BAJACAN_PROFILER_TCB.INTFLAGS & TCB_CAPT_bm) != 0U && low < 0x8000U) {
+    ++high;
+  }
+  SREG = sreg;
+  return (static_cast<uint32_t>(high) << 16) | low;
+}
+
+void LoopProfilerRecord(const LoopPhase phase, const uint32_t startTicks) {
+  const uint32_t elapsed = LoopProfilerNow() - startTicks;
+  PhaseStats &stats = gPhases[static_cast<uint8_t>(phase)];
+  stats.totalCycles = (UINT32_MAX - stats.totalCycles < elapsed)
+                          ? UINT32_MAX
+                          : stats.totalCycles + elapsed;
+  if (elapsed > stats.worstCycles) {
+    stats.worstCycles = elapsed;
+  }
+  if (stats.calls < UINT16_MAX) {
+    ++stats.calls;
+  }
+}
+
+void LoopProfilerBuildReport(CANFDMessage &outFrame) {
+  outFrame.id = gReportId;
+  outFrame.ext = gUseExtendedIds;
+  outFrame.len = kReportBytes;
+  uint8_t at = 0;
+  for (uint8_t i = 0; i < kPhaseCount; ++i) {
+    const PhaseStats &stats = gPhases[i];
+    at = Put32(outFrame, at, stats.totalCycles);
+    at = Put32(outFrame, at, stats.worstCycles);
+    at = Put16(outFrame, at, stats.calls);
+  }
+  while (at < kReportBytes) {
+    outFrame.data[at++] = 0;
+  }
+  memset(gPhases, 0, sizeof(gPhases));
+}
+#endif
@@ -4,9 +4,15 @@
 #include <avr/sleep.h>
 
 #include "config.h"        // Common contracts for board configs
+#include "boot_report.h"
 #include "debug_print.h"
+#include "loop_profiler.h"
+#include "phase_plan.h"
+#include "ram_budget.h"
+#include "sensor_stats.h"
 #include <analog_sensor.h>
 #include <can_driver.h>
+#include <spi_bus.h>
 #include <sensors_config.h>  // Provided by the selected board environment
 
 namespace {
@@ -14,23 +20,152 @@ namespace {
 // ACAN2517FD driver instance configured with board-provided pins.
 ACAN2517FD gCanDriver{kBoardConfig.canCsPin, SPI, kBoardConfig.canIntPin};
 // TEMP: Toggle pin on CAN TX for scope frequency checks (remove when done).
+// Driven from OnSensorTx only.
 constexpr uint8_t kCanTxTogglePin = 3;
 bool gCanTxToggleState = false;
 
+void ToggleCanTxPin() {
+  gCanTxToggleState = !gCanTxToggleState;
+  digitalWrite(kCanTxTogglePin, gCanTxToggleState ? HIGH : LOW);
+}
+
 enum class NodeState { Awake, Sleeping };
 NodeState gNodeState = NodeState::Awake;
 
 volatile bool gSleepRequested = false;
 volatile bool gWakeRequested = false;
 
+// Payload bytes remembered per sensor for change-triggered transmission.
+constexpr uint8_t kChangeCompareBytes = 8;
+
+// Per-sensor scheduler state. Descriptors and contexts are not cached here;
+// they are read from the board table (see SensorDesc).
 struct SensorRuntime {
-  const SensorDescriptor *desc;
-  const SensorContext *context;
   uint32_t nextPollAtMs;
+  // Two-phase sensors: a conversion is in flight, due at dueAtMs and
+  // collectable from collectAtMs.
+  bool converting;
+  uint32_t dueAtMs;
+  uint32_t collectAtMs;
+  uint32_t lastSentAtMs;
+  bool hasLastSent;
+  uint8_t lastSentLen;
+  uint8_t lastSentData[kChangeCompareBytes];
 };
 
 constexpr size_t kSensorCount = kBoardConfig.sensorCount;
-SensorRuntime gSensorRuntime[kSensorCount > 0 ? kSensorCount : 1];
+constexpr size_t kSensorSlots = kSensorCount > 0 ? kSensorCount : 1;
+SensorRuntime gSensorRuntime[kSensorSlots];
+// Sensors are sampled one at a time, so they share one output frame (or
+// batch) instead of constructing a zero-filled CANFDMessage per poll. Only id,
+// ext and len are reset; sensors write data[0..len) and pad() as needed.
+// Sensors still fill a full CANFDMessage: there is no payload-sized frame or
+// writer into the driver's SPI buffer. When the controller TX FIFO has room,
+// tryToSend copies only the header and len bytes into its SPI buffer; when
+// it is full, the whole CANFDMessage is copied into the driver's FIFO.
+CANFDMessage gSampleFrame;
+
+// A variable template is only instantiated where a batch slot's
+// `if constexpr` branch uses it, so boards without one carry no batch buffer.
+template <typename = void>
+SensorFrameBatch gFrameBatch;
+
+// Set from sensor data-ready interrupts; see SensorDescriptor::attachDataReady.
+volatile bool gSensorReady[kSensorSlots];
+
+#if BAJACAN_ENABLE_SENSOR_STATS
+SensorStats gSensorStats[kSensorSlots];
+#endif
+
+template <size_t kIndex>
+void OnSensorDataReady() {
+  gSensorReady[kIndex] = true;
+}
+
+// One ISR-safe callback per sensor slot, generated at compile time because
+// attachInterrupt() handlers take no arguments.
+template <size_t... kIndices>
+struct IndexList {};
+
+template <size_t kCount, size_t... kIndices>
+struct MakeIndexList : MakeIndexList<kCount - 1, kCount - 1, kIndices...> {};
+
+template <size_t... kIndices>
+struct MakeIndexList<0, kIndices...> {
+  using type = IndexList<kIndices...>;
+};
+
+struct DataReadyHandlers {
+  void (*handler[kSensorSlots])();
+};
+
+template <size_t... kIndices>
+constexpr DataReadyHandlers MakeDataReadyHandlers(IndexList<kIndices...>) {
+  return DataReadyHandlers{{&OnSensorDataReady<kIndices>...}};
+}
+
+constexpr DataReadyHandlers kDataReadyHandlers =
+    MakeDataReadyHandlers(MakeIndexList<kSensorSlots>::type{});
+
+// First-poll offsets chosen at compile time to minimize per-tick TX bursts.
+constexpr SensorPhasePlan<kSensorSlots> kPhasePlan =
+    PlanSensorPhases<kSensorSlots>(kBoardConfig.sensors, kSensorCount);
+
+#if BAJACAN_REPORT_PHASE_PLAN
+static_assert(ReportPhasePlan<kPhasePlan.peakFramesPerMs,
+                              kPhasePlan.peakCostUsPerMs,
+                              kPhasePlan.windowMs>(),
+              "phase plan report");
+#endif
+
+static_assert(AnalogAdcOwnershipValid(kBoardConfig.sensors, kSensorCount),
+              "An AnalogMode::Triggered or Windowed sensor must be the only "
+              "analog sensor on the board");
+
+// Analog Scan sensors, in board order; AnalogScanBegin() resolves them once.
+static_assert(CountAnalogScanSensors(kBoardConfig.sensors, kSensorCount) <=
+                  kAnalogMaxScanChannels,
+              "Too many AnalogMode::Scan sensors (kAnalogMaxScanChannels)");
+constexpr AnalogScanTable kAnalogScan BAJACAN_FLASH_TABLE =
+    MakeAnalogScanTable(kBoardConfig.sensors, kSensorCount);
+
+// Bit timing is searched for at compile time; ConfigureCan() copies the
+// result from flash instead of running the prescaler/segment search on every
+// boot. Both the arbitration and the data bit rate must be within tolerance.
+constexpr uint32_t kCanBitRateTolerancePpm = 1000;
+constexpr ACAN2517FDSettings kCanTiming BAJACAN_FLASH_TABLE{
+    kBoardConfig.canOscillator, kBoardConfig.arbitrationBitrate,
+    kBoardConfig.dataBitrateFactor, kCanBitRateTolerancePpm};
+static_assert(kCanTiming.CANBitSettingConsistency() == 0U,
+              "No valid MCP251863 bit timing for canOscillator, "
+              "arbitrationBitrate and dataBitrateFactor");
+static_assert(kCanTiming.ppmFromDesiredArbitrationBitRate() <=
+                  kCanBitRateTolerancePpm,
+              "arbitrationBitrate is more than 1000 ppm off what "
+              "canOscillator can produce");
+static_assert(kCanTiming.ppmFromDesiredDataBitRate() <=
+                  kCanBitRateTolerancePpm,
+              "arbitrationBitrate * dataBitrateFactor is more than 1000 ppm "
+              "off what canOscillator can produce");
+
+constexpr CanBufferConfig kCanBuffers = kBoardConfig.canBuffers;
+static_assert(CanBuffersValid(kCanBuffers),
+              "canBuffers: controller FIFOs hold 1..32 objects (TXQ 0..32) "
+              "and the driver receive FIFO needs at least one frame");
+static_assert(McpRamUsage(kCanBuffers) <= kMcpMessageRamBytes,
+              "canBuffers do not fit the MCP251863's 2 KB message RAM; "
+              "shrink a controller FIFO or its payload size");
+
+static_assert(CanDriverRamUsage(kCanBuffers) <= BAJACAN_CAN_FIFO_RAM_BUDGET,
+              "CAN driver FIFOs exceed BAJACAN_CAN_FIFO_RAM_BUDGET; shrink "
+              "canBuffers' driver FIFOs or raise the budget");
+
+#if BAJACAN_REPORT_RAM_BUDGET
+static_assert(ReportRamBudget<McpRamUsage(kCanBuffers),
+                              CanDriverRamUsage(kCanBuffers),
+                              BAJACAN_CAN_FIFO_RAM_BUDGET>(),
+              "RAM budget report");
+#endif
 
 void CallIfSet(void (*hook)()) {
   if (hook != nullptr) {
@@ -38,31 +173,22 @@ void CallIfSet(void (*hook)()) {
   }
 }
 
-const SensorContext *GetSensorContext(const SensorDescriptor &desc) {
-  return static_cast<const SensorContext *>(desc.context);
+// The board table may live in mapped flash (BAJACAN_FLASH_TABLE); reading it
+// in place costs the same as reading a pointer cached in SRAM.
+const SensorDescriptor &SensorDesc(const size_t index) {
+  return kBoardConfig.sensors[index];
 }
 
-size_t CountActiveSensors() {
-  size_t count = 0;
-  for (size_t i = 0; i < kBoardConfig.sensorCount; ++i) {
-    const SensorContext *context = GetSensorContext(kBoardConfig.sensors[i]);
-    if (context != nullptr && context->pollIntervalMs > 0U) {
-      ++count;
-    }
-  }
-  return count;
+const SensorContext *GetSensorContext(const size_t index) {
+  return SensorDesc(index).base;
 }
 
-uint32_t StaggeredFirstPollTime(const uint32_t nowMs,
-                                const uint16_t pollIntervalMs,
-                                const size_t activeIndex,
-                                const size_t activeCount) {
-  if (pollIntervalMs == 0U || activeCount <= 1U) {
-    return nowMs + pollIntervalMs;
+uint32_t FirstPollTime(const uint32_t nowMs, const size_t index,
+                       const SensorContext *context) {
+  if (context == nullptr || context->pollIntervalMs == 0U) {
+    return nowMs;
   }
-  const uint32_t offset =
-      (static_cast<uint32_t>(pollIntervalMs) * activeIndex) / activeCount;
-  return nowMs + offset;
+  return nowMs + kPhasePlan.offsetMs[index];
 }
 
 void OnWakeFlag() {
@@ -70,19 +196,61 @@ void OnWakeFlag() {
   gSleepRequested = false;
 }
 
+void OnCanInterrupt();
+
+// The driver's ISR must not start SPI traffic inside a sensor's transfer.
+// INT is level-triggered, so it is detached while deferred and re-attached
+// once the bus is free; if INT is still low it fires again right away.
+void ResumeCanInterrupt() {
+  attachInterrupt(digitalPinToInterrupt(kBoardConfig.canIntPin),
+                  OnCanInterrupt, LOW);
+}
+
 void OnCanInterrupt() {
+  if (SpiBusBusy()) {
+    detachInterrupt(digitalPinToInterrupt(kBoardConfig.canIntPin));
+    SpiBusDefer(SpiPriority::High, ResumeCanInterrupt);
+    return;
+  }
   gCanDriver.isr();
 }
 
-bool ConfigureCan() {
-  ACAN2517FDSettings settings{kBoardConfig.canOscillator,
-                              kBoardConfig.arbitrationBitrate,
-                              kBoardConfig.dataBitrateFactor};
+bool ConfigureCan(const bool skipSelfTest) {
+  ACAN2517FDSettings settings = kCanTiming;
+  // Fast boot (boot_report.h): FinishCanStartup() waits for NormalFD instead.
+  settings.mSkipSPIReadBackTests = skipSelfTest;
+  settings.mWaitForRequestedMode = !BAJACAN_FAST_BOOT;
   settings.mRequestedMode = ACAN2517FDSettings::NormalFD;
+  settings.mDriverTransmitFIFOSize = kCanBuffers.driverTransmitFifoSize;
+  settings.mControllerTransmitFIFOSize =
+      kCanBuffers.controllerTransmitFifoSize;
+  settings.mControllerTransmitFIFOPayload =
+      kCanBuffers.controllerTransmitFifoPayload;
+  settings.mControllerTXQSize = kCanBuffers.controllerTxqSize;
+  settings.mControllerTXQBufferPayload = kCanBuffers.controllerTxqPayload;
+  settings.mDriverReceiveFIFOSize = kCanBuffers.driverReceiveFifoSize;
+  settings.mControllerReceiveFIFOSize = kCanBuffers.controllerReceiveFifoSize;
+  settings.mControllerReceiveFIFOPayload =
+      kCanBuffers.controllerReceiveFifoPayload;
   const uint32_t errorCode = gCanDriver.begin(settings, OnCanInterrupt);
   return errorCode == 0U;
 }
 
+bool FinishCanStartup() {
+#if BAJACAN_FAST_BOOT
+  return gCanDriver.waitForRequestedMode() == 0U;
+#else
+  return true;
+#endif
+}
+
+void HaltOnCanFailure() {
+  // TODO: Surface CAN init failure via LED blink or debug UART.
+  while (true) {
+    delay(100);
+  }
+}
+
 bool MatchesCommand(const CANFDMessage &frame, const uint32_t expectedId,
                     const uint8_t expectedByte) {
   // Only consider frames with the expected ID type.
@@ -101,12 +269,34 @@ bool MatchesCommand(const CANFDMessage &frame, const uint32_t expectedId,
   return frame.data[kBoardConfig.control.commandByteIndex] == expectedByte;
 }
 
+#if BAJACAN_ENABLE_SENSOR_STATS
+void SendSensorStats(const bool resetAfter) {
+  CANFDMessage report;
+  for (size_t i = 0; SensorStatsBuildFrame(i, report); ++i) {
+    gCanDriver.tryToSend(report);
+  }
+  if (resetAfter) {
+    SensorStatsReset();
+  }
+}
+#endif
+
 void HandleControlFrame(const CANFDMessage &frame) {
   if (MatchesCommand(frame, kBoardConfig.control.sleepCommandId,
                      kBoardConfig.control.sleepCommandByte)) {
     gSleepRequested = true;
     gWakeRequested = false;
   }
+
+#if BAJACAN_ENABLE_SENSOR_STATS
+  if (frame.ext == kBoardConfig.useExtendedIds &&
+      frame.id == kBoardConfig.diagnostics.requestId && frame.len > 0) {
+    if (frame.data[0] == kSensorStatsDump ||
+        frame.data[0] == kSensorStatsDumpAndReset) {
+      SendSensorStats(frame.data[0] == kSensorStatsDumpAndReset);
+    }
+  }
+#endif
 }
 
 void ServiceIncomingCan() {
@@ -120,92 +310,374 @@ void ServiceIncomingCan() {
 }
 
 void InitializeSensors() {
+  if constexpr (kAnalogScan.count > 0U) {
+    const bool ok = AnalogScanBegin(kAnalogScan);
+    (void)ok;  // Scan sensors fail begin() below if this did.
+  }
   const uint32_t now = millis();
-  const size_t activeCount = CountActiveSensors();
-  size_t activeIndex = 0;
   for (size_t i = 0; i < kBoardConfig.sensorCount; ++i) {
     SensorRuntime &runtime = gSensorRuntime[i];
-    runtime.desc = &kBoardConfig.sensors[i];
-    runtime.context = GetSensorContext(*runtime.desc);
-    const uint16_t pollIntervalMs =
-        runtime.context != nullptr ? runtime.context->pollIntervalMs : 0U;
-    if (runtime.context != nullptr && pollIntervalMs > 0U) {
-      runtime.nextPollAtMs =
-          StaggeredFirstPollTime(now, pollIntervalMs, activeIndex, activeCount);
-      ++activeIndex;
-    } else {
-      runtime.nextPollAtMs = now + pollIntervalMs;
-    }
+    const SensorDescriptor &desc = SensorDesc(i);
+    runtime.nextPollAtMs = FirstPollTime(now, i, desc.base);
+    runtime.converting = false;
+    runtime.hasLastSent = false;
 
-    if (runtime.context == nullptr) {
+    if (desc.base == nullptr) {
       continue;
     }
 
-    if (runtime.desc->begin != nullptr) {
-      const bool ok = runtime.desc->begin(runtime.desc->context);
+    if (desc.begin != nullptr) {
+      const bool ok = desc.begin(desc.context);
       (void)ok;  // TODO: surface init failures via CAN or a status LED.
     }
+
+    if (desc.attachDataReady != nullptr) {
+      gSensorReady[i] = false;
+      desc.attachDataReady(desc.context, kDataReadyHandlers.handler[i]);
+    }
   }
 }
 
-void PollSensors(const uint32_t nowMs) {
-  for (size_t i = 0; i < kBoardConfig.sensorCount; ++i) {
-    SensorRuntime &runtime = gSensorRuntime[i];
-    const SensorDescriptor &desc = *runtime.desc;
-    const SensorContext *context = runtime.context;
+// True once nowMs is at or past atMs. The signed difference stays correct
+// across the millis() wrap as long as the two are within ~24 days.
+bool TimeReached(const uint32_t nowMs, const uint32_t atMs) {
+  return static_cast<int32_t>(nowMs - atMs) >= 0;
+}
 
-    if (context == nullptr) {
-      continue;
+// Returns true when sensor `index` should be sampled now and advances its
+// schedule. scheduledAt receives the time the sample was due.
+bool TakeDueSensor(const size_t index, const uint32_t nowMs,
+                   uint32_t &scheduledAt) {
+  SensorRuntime &runtime = gSensorRuntime[index];
+  const SensorDescriptor &desc = SensorDesc(index);
+  const uint32_t intervalMs = desc.base->pollIntervalMs;
+
+  if (desc.attachDataReady != nullptr && gSensorReady[index]) {
+    gSensorReady[index] = false;  // Cleared first so a new edge is not lost.
+    scheduledAt = nowMs;
+    runtime.nextPollAtMs = nowMs + intervalMs;  // Fallback poll restarts.
+    return true;
+  }
+
+  if (intervalMs == 0U) {
+    return false;  // Disabled, or purely event-driven.
+  }
+
+  if (!TimeReached(nowMs, runtime.nextPollAtMs)) {
+    return false;
+  }
+
+  scheduledAt = runtime.nextPollAtMs;
+  uint32_t nextPoll = scheduledAt + intervalMs;
+  if (TimeReached(nowMs, nextPoll)) {
+    nextPoll = nowMs + intervalMs;
+  }
+  runtime.nextPollAtMs = nextPoll;
+  return true;
+}
+
+bool PayloadMoved(const SensorRuntime &runtime, const CANFDMessage &frame,
+                  const uint16_t deadband) {
+  if (!runtime.hasLastSent || frame.len != runtime.lastSentLen ||
+      frame.len > kChangeCompareBytes) {
+    return true;
+  }
+  for (uint8_t i = 0; i < frame.len; i += 2) {
+    uint16_t previous = runtime.lastSentData[i];
+    uint16_t current = frame.data[i];
+    if (i + 1U < frame.len) {
+      previous = (previous << 8) | runtime.lastSentData[i + 1];
+      current = (current << 8) | frame.data[i + 1];
+    }
+    const uint16_t delta =
+        current > previous ? current - previous : previous - current;
+    if (delta > deadband) {
+      return true;
     }
+  }
+  return false;
+}
+
+// True when change-triggered transmission is enabled for the sensor and the
+// frame carries nothing new yet.
+bool ShouldSuppress(const size_t index, const CANFDMessage &frame,
+                    const uint32_t nowMs) {
+  const SensorRuntime &runtime = gSensorRuntime[index];
+  const SensorContext &context = *GetSensorContext(index);
+  if (context.maxSilenceMs == 0U) {
+    return false;
+  }
+  if (nowMs - runtime.lastSentAtMs >= context.maxSilenceMs) {
+    return false;  // Heartbeat due.
+  }
+  return !PayloadMoved(runtime, frame, context.deadband);
+}
+
+void RememberSent(SensorRuntime &runtime, const CANFDMessage &frame,
+                  const uint32_t nowMs) {
+  runtime.lastSentAtMs = nowMs;
+  runtime.hasLastSent = true;
+  runtime.lastSentLen = frame.len;
+  const uint8_t count =
+      frame.len < kChangeCompareBytes ? frame.len : kChangeCompareBytes;
+  memcpy(runtime.lastSentData, frame.data, count);
+}
+
+constexpr bool IsTwoPhase(const SensorDescriptor &desc) {
+  return desc.startConversion != nullptr && desc.collect != nullptr;
+}
 
-    if (context->pollIntervalMs == 0U) {
-      continue;  // Disabled sensor.
+// The sampling steps below are instantiated per table slot. Hooks and
+// contexts come straight from the constexpr board table, so each call is a
+// direct call on a constant context that link-time optimization can inline
+// and fold against the sensor's config, instead of an indirect call through
+// SensorRuntime.
+template <size_t kIndex>
+constexpr const SensorDescriptor &kSlotDesc = kBoardConfig.sensors[kIndex];
+
+// Runs the slot's synchronous hook; batches land in gFrameBatch.
+template <size_t kIndex>
+bool InvokeSample(CANFDMessage &frame) {
+  constexpr const SensorDescriptor &desc = kSlotDesc<kIndex>;
+  if constexpr (desc.sampleBatch != nullptr) {
+    gFrameBatch<>.reset(frame.id, frame.ext);
+    return desc.sampleBatch(desc.context, gFrameBatch<>);
+  } else {
+    return desc.sample(desc.context, frame);
+  }
+}
+
+// Synchronous sensors: samples sensor kIndex if it is due. True when `frame`
+// (or gFrameBatch, for batch sensors) holds samples to send.
+template <size_t kIndex>
+bool SampleIfDue(const uint32_t nowMs, CANFDMessage &frame) {
+  constexpr const SensorDescriptor &desc = kSlotDesc<kIndex>;
+  if constexpr (desc.sample == nullptr && desc.sampleBatch == nullptr) {
+    return false;
+  } else {
+    uint32_t scheduledAt = nowMs;
+    if (!TakeDueSensor(kIndex, nowMs, scheduledAt)) {
+      return false;
     }
 
-    if (nowMs < runtime.nextPollAtMs) {
-      continue;
+#if BAJACAN_ENABLE_SENSOR_STATS
+    const uint32_t sampleStartUs = micros();
+#endif
+    // Sample function populates frame len and data, true if successful
+    const bool sampled = InvokeSample<kIndex>(frame);
+#if BAJACAN_ENABLE_SENSOR_STATS
+    SensorStatsRecordPoll(kIndex, nowMs - scheduledAt,
+                          micros() - sampleStartUs);
+    if (!sampled) {
+      SensorStatsRecordTx(kIndex, SensorTxOutcome::Skipped);
     }
+#else
+    (void)scheduledAt;
+#endif
+    return sampled;  // If sample returns false, skip trying to send
+  }
+}
 
-    {
-      const uint32_t scheduledAt = runtime.nextPollAtMs;
-      const uint32_t intervalMs = context->pollIntervalMs;
-      uint32_t nextPoll = scheduledAt + intervalMs;
-      if (nextPoll <= nowMs) {
-        nextPoll = nowMs + intervalMs;
-      }
-      runtime.nextPollAtMs = nextPoll;
+// Two-phase sensors: starts a conversion conversionMs ahead of each due poll,
+// then collects it on later passes. A conversion still Pending a full poll
+// interval after it was due is abandoned and counted as Failed, so a stuck
+// sensor cannot stop its own schedule. True when `frame` holds a sample to
+// send.
+template <size_t kIndex>
+bool AdvanceConversion(const uint32_t nowMs, CANFDMessage &frame) {
+  constexpr const SensorDescriptor &desc = kSlotDesc<kIndex>;
+  constexpr uint16_t conversionMs = desc.base->conversionMs;
+  SensorRuntime &runtime = gSensorRuntime[kIndex];
+
+  if (!runtime.converting) {
+    uint32_t dueAt = nowMs;
+    if (!TakeDueSensor(kIndex, nowMs + conversionMs, dueAt)) {
+      return false;
+    }
+    if (!desc.startConversion(desc.context)) {
+#if BAJACAN_ENABLE_SENSOR_STATS
+      SensorStatsRecordTx(kIndex, SensorTxOutcome::Skipped);
+#endif
+      return false;
     }
+    runtime.converting = true;
+    runtime.dueAtMs = dueAt;
+    runtime.collectAtMs = nowMs + conversionMs;
+  }
 
-    if (desc.sample == nullptr) {
-      continue;
+  if (!TimeReached(nowMs, runtime.collectAtMs)) {
+    return false;
+  }
+
+#if BAJACAN_ENABLE_SENSOR_STATS
+  const uint32_t collectStartUs = micros();
+#endif
+  SensorCollectResult result = desc.collect(desc.context, frame);
+  if (result == SensorCollectResult::Pending) {
+    if (!TimeReached(nowMs, runtime.dueAtMs + desc.base->pollIntervalMs)) {
+      return false;
+    }
+    if constexpr (desc.cancel != nullptr) {
+      desc.cancel(desc.context);
     }
+    result = SensorCollectResult::Failed;
+  }
+  runtime.converting = false;
+#if BAJACAN_ENABLE_SENSOR_STATS
+  // Latency is counted to the final collect; cost is that collect's alone.
+  SensorStatsRecordPoll(kIndex, nowMs - runtime.dueAtMs,
+                        micros() - collectStartUs);
+  if (result == SensorCollectResult::Failed) {
+    SensorStatsRecordTx(kIndex, SensorTxOutcome::Skipped);
+  }
+#endif
+  return result == SensorCollectResult::Ready;
+}
+
+// Runs after every sensor transmit attempt, single frame or batch.
+void OnSensorTx(const bool anySent) {
+  if (anySent) {
+    BootReportMark(BootPhase::FirstFrame);
+  }
+  ToggleCanTxPin();
+}
+
+// Shared by every slot: change suppression, transmission and bookkeeping.
+void TransmitSample(const size_t index, const CANFDMessage &frame,
+                    const uint32_t nowMs) {
+  SensorRuntime &runtime = gSensorRuntime[index];
+  if (ShouldSuppress(index, frame, nowMs)) {
+#if BAJACAN_ENABLE_SENSOR_STATS
+    SensorStatsRecordTx(index, SensorTxOutcome::Suppressed);
+#endif
+    return;
+  }
+
+  bool sent;
+  {
+    LoopPhaseScope txScope(LoopPhase::CanTx);
+    sent = gCanDriver.tryToSend(frame);
+  }
+  if (sent) {
+    RememberSent(runtime, frame, nowMs);
+  }
+#if BAJACAN_ENABLE_SENSOR_STATS
+  SensorStatsRecordTx(index, sent ? SensorTxOutcome::Sent
+                                  : SensorTxOutcome::Failed);
+#endif
+  OnSensorTx(sent);
 
-    CANFDMessage frame;
-    frame.id = context->canId;
+
+#if BAJACAN_ENABLE_DEBUG_PRINTS
+  {
+    LoopPhaseScope printScope(LoopPhase::DebugPrints);
+    PrintSensorPoll(GetSensorContext(index)->name, frame, nowMs);
+    PrintCanTxResult(frame, nowMs, sent);
+  }
+#endif
+}
+
+// All frames of a batch go to the driver in one call; the batch counts as
+// sent only if every frame was accepted.
+void TransmitBatch(const size_t index, const SensorFrameBatch &batch,
+                   const uint32_t nowMs) {
+  const uint8_t count = batch.size();
+  if (count == 0U) {
+    return;
+  }
+  uint8_t sent;
+  {
+    LoopPhaseScope txScope(LoopPhase::CanTx);
+    sent = gCanDriver.tryToSendBatch(batch.frames(), count);
+  }
+#if BAJACAN_ENABLE_SENSOR_STATS
+  SensorStatsRecordTx(index, sent == count ? SensorTxOutcome::Sent
+                                           : SensorTxOutcome::Failed);
+#endif
+  OnSensorTx(sent > 0U);
+
+#if BAJACAN_ENABLE_DEBUG_PRINTS
+  {
+    LoopPhaseScope printScope(LoopPhase::DebugPrints);
+    for (uint8_t i = 0; i < count; ++i) {
+      const CANFDMessage &frame = batch.frames()[i];
+      PrintSensorPoll(GetSensorContext(index)->name, frame, nowMs);
+      PrintCanTxResult(frame, nowMs, i < sent);
+    }
+  }
+#else
+  (void)index;
+  (void)nowMs;
+  (void)sent;
+#endif
+}
+
+template <size_t kIndex>
+void PollSensor(const uint32_t nowMs) {
+  constexpr const SensorDescriptor &desc = kSlotDesc<kIndex>;
+  if constexpr (desc.base != nullptr) {
+    CANFDMessage &frame = gSampleFrame;
+    frame.id = desc.base->canId;
     frame.ext = kBoardConfig.useExtendedIds;
     frame.len = 0;
 
-    // Sample function populates frame len and data, true if successful
-    if (!desc.sample(desc.context, frame)) {
-      continue;  // If sample returns false, skip trying to send
+    bool sampled;
+    if constexpr (IsTwoPhase(desc)) {
+      sampled = AdvanceConversion<kIndex>(nowMs, frame);
+    } else {
+      sampled = SampleIfDue<kIndex>(nowMs, frame);
     }
+    if (!sampled) {
+      return;
+    }
+    if constexpr (!IsTwoPhase(desc) && desc.sampleBatch != nullptr) {
+      TransmitBatch(kIndex, gFrameBatch<>, nowMs);
+    } else {
+      TransmitSample(kIndex, frame, nowMs);
+    }
+  }
+}
 
-    const bool sent = gCanDriver.tryToSend(frame);
-    // TEMP: Toggle pin on CAN TX for scope frequency checks (remove when done).
-    gCanTxToggleState = !gCanTxToggleState;
-    digitalWrite(kCanTxTogglePin, gCanTxToggleState ? HIGH : LOW);
+// Unrolled at compile time over the board's sensor table.
+template <size_t... kIndices>
+void PollSensors(const uint32_t nowMs, IndexList<kIndices...>) {
+  (PollSensor<kIndices>(nowMs), ...);
+}
 
+void PollSensors(const uint32_t nowMs) {
+  PollSensors(nowMs, MakeIndexList<kSensorCount>::type{});
+}
 
-#if BAJACAN_ENABLE_DEBUG_PRINTS
-    PrintSensorPoll(context->name, frame, nowMs);
-    PrintCanTxResult(frame, nowMs, sent);
+#if BAJACAN_ENABLE_LOOP_PROFILER
+uint32_t gNextProfilerReportAtMs = 0;
+
+void SendLoopProfileIfDue(const uint32_t nowMs) {
+  if (!TimeReached(nowMs, gNextProfilerReportAtMs)) {
+    return;
+  }
+  gNextProfilerReportAtMs = nowMs + kLoopProfilerReportMs;
+  CANFDMessage report;
+  LoopProfilerBuildReport(report);
+  gCanDriver.tryToSend(report);
+}
 #endif
+
+#if BAJACAN_ENABLE_BOOT_REPORT
+void SendBootReportIfReady() {
+  if (!BootReportPending()) {
+    return;
+  }
+  CANFDMessage report;
+  BootReportBuild(report);
+  if (gCanDriver.tryToSend(report)) {
+    BootReportSent();
   }
 }
+#endif
 
 void SuspendSensorsForSleep() {
   for (size_t i = 0; i < kBoardConfig.sensorCount; ++i) {
-    const SensorDescriptor &desc = *gSensorRuntime[i].desc;
+    const SensorDescriptor &desc = SensorDesc(i);
     if (desc.suspend != nullptr) {
       desc.suspend(desc.context);
     }
@@ -214,21 +686,13 @@ void SuspendSensorsForSleep() {
 
 void ResumeSensorsAfterWake() {
   const uint32_t now = millis();
-  const size_t activeCount = CountActiveSensors();
-  size_t activeIndex = 0;
   for (size_t i = 0; i < kBoardConfig.sensorCount; ++i) {
     SensorRuntime &runtime = gSensorRuntime[i];
-    const SensorDescriptor &desc = *runtime.desc;
-    const SensorContext *context = runtime.context;
-    const uint16_t pollIntervalMs =
-        context != nullptr ? context->pollIntervalMs : 0U;
-    if (context != nullptr && pollIntervalMs > 0U) {
-      runtime.nextPollAtMs =
-          StaggeredFirstPollTime(now, pollIntervalMs, activeIndex, activeCount);
-      ++activeIndex;
-    } else {
-      runtime.nextPollAtMs = now + pollIntervalMs;
-    }
+    const SensorDescriptor &desc = SensorDesc(i);
+    runtime.nextPollAtMs = FirstPollTime(now, i, desc.base);
+    runtime.converting = false;   // Conversions do not survive suspend.
+    runtime.hasLastSent = false;  // First frame after wake always goes out.
+    gSensorReady[i] = false;      // Drop events latched while asleep.
     if (desc.resume != nullptr) {
       desc.resume(desc.context);
     }
@@ -273,6 +737,8 @@ void WakeIfRequested() {
 }  // namespace
 
 void setup() {
+  const uint8_t resetFlags = BootCaptureResetFlags();
+  BootReportMark(BootPhase::SetupStart);
   CallIfSet(kBoardConfig.hooks.preSetup);
 
   pinMode(kBoardConfig.canCsPin, OUTPUT);
@@ -285,34 +751,66 @@ void setup() {
   Serial.begin(115200); // Serial0 for debug
 #endif
 
-  if (!ConfigureCan()) {
-    // TODO: Surface CAN init failure via LED blink or debug UART.
-    while (true) {
-      delay(100);
-    }
+  const bool skipSelfTest = BAJACAN_FAST_BOOT && BootIsWarmReset(resetFlags);
+  BootReportBegin(resetFlags, skipSelfTest,
+                  kBoardConfig.diagnostics.bootReportId,
+                  kBoardConfig.useExtendedIds);
+  if (!ConfigureCan(skipSelfTest)) {
+    HaltOnCanFailure();
   }
+  BootReportMark(BootPhase::CanConfigured);
   gCanDriver.setWakeHandler(OnWakeFlag);
   gCanDriver.enableWakeInterrupt();
   gCanDriver.clearWakeFlag();
 
   InitializeSensors();
+  BootReportMark(BootPhase::SensorsStarted);
+  if (!FinishCanStartup()) {
+    HaltOnCanFailure();
+  }
+  BootReportMark(BootPhase::CanReady);
+  LoopProfilerBegin(kBoardConfig.diagnostics.profilerId,
+                    kBoardConfig.useExtendedIds);
+#if BAJACAN_ENABLE_SENSOR_STATS
+  SensorStatsBegin(gSensorStats, kSensorCount,
+                   kBoardConfig.diagnostics.responseId,
+                   kBoardConfig.useExtendedIds);
+#endif
 }
 
 void loop() {
+  LoopPhaseScope loopScope(LoopPhase::Loop);
   const uint32_t now = millis();
 
   // Always service CAN to detect wake packets and other inbound commands.
-  ServiceIncomingCan();
-  WakeIfRequested();
+  {
+    LoopPhaseScope scope(LoopPhase::ServiceIncomingCan);
+    ServiceIncomingCan();
+  }
+  {
+    LoopPhaseScope scope(LoopPhase::WakeIfRequested);
+    WakeIfRequested();
+  }
 
   if (gNodeState == NodeState::Sleeping) {
+    loopScope.discard();   // Time spent asleep is not loop work.
     EnterLowPowerSleep();  // Pauses after execution until interrupt
     sleep_disable();       // Wake CPU immediately on interrupt
     WakeIfRequested();     // Wake flag set by ISR
     return;
   }
 
-  PollSensors(now);
+  {
+    LoopPhaseScope scope(LoopPhase::PollSensors);
+    PollSensors(now);
+  }
+
+#if BAJACAN_ENABLE_LOOP_PROFILER
+  SendLoopProfileIfDue(now);
+#endif
+#if BAJACAN_ENABLE_BOOT_REPORT
+  SendBootReportIfReady();
+#endif
 
   if (gSleepRequested) {
     PrepareForSleep();
@@ -0,0 +1,152 @@
+#include <Arduino.h>
+#include <sensor_stats.h>
+
+#if BAJACAN_ENABLE_SENSOR_STATS
+namespace {
+
+constexpr uint8_t kHistogramBuckets = kSensorStatsHistogramBuckets;
+constexpr uint8_t kSampleHistogramShift = 3;  // First bucket covers 0-7 us.
+
+SensorStats *gStats = nullptr;
+size_t gStatsCount = 0;
+uint32_t gResponseId = 0;
+bool gUseExtendedIds = false;
+
+// Bucket b holds values whose bit length (after shift) is b; the last bucket
+// collects everything larger.
+uint8_t BucketFor(uint32_t value, const uint8_t shift) {
+  value >>= shift;
+  uint8_t bucket = 0;
+  while (value != 0U && bucket < kHistogramBuckets - 1U) {
+    value >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void Record(SensorTimingStat &stat, const uint32_t value, const bool first,
+            const uint8_t shift) {
+  if (first || value < stat.min) {
+    stat.min = value;
+  }
+  if (value > stat.max) {
+    stat.max = value;
+  }
+  stat.sum = (UINT32_MAX - stat.sum < value) ? UINT32_MAX : stat.sum + value;
+  uint16_t &bucket = stat.histogram[BucketFor(value, shift)];
+  if (bucket < UINT16_MAX) {
+    ++bucket;
+  }
+}
+
+void Increment(uint32_t &counter) {
+  if (counter < UINT32_MAX) {
+    ++counter;
+  }
+}
+
+uint16_t Saturate16(const uint32_t value) {
+  return value > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(value);
+}
+
+uint8_t Put16(CANFDMessage &frame, uint8_t at, const uint16_t value) {
+  frame.data[at++] = value >> 8;
+  frame.data[at++] = value & 0xFF;
+  return at;
+}
+
+uint8_t Put32(CANFDMessage &frame, uint8_t at, const uint32_t value) {
+  at = Put16(frame, at, static_cast<uint16_t>(value >> 16));
+  return Put16(frame, at, static_cast<uint16_t>(value & 0xFFFF));
+}
+
+uint8_t PutTiming(CANFDMessage &frame, uint8_t at,
+                  const SensorTimingStat &stat, const uint32_t polls) {
+  at = Put16(frame, at, Saturate16(stat.min));
+  at = Put16(frame, at, Saturate16(stat.max));
+  return Put16(frame, at, Saturate16(polls > 0U ? stat.sum / polls : 0U));
+}
+
+uint8_t PutHistogram(CANFDMessage &frame, uint8_t at,
+                     const SensorTimingStat &stat) {
+  for (uint8_t i = 0; i < kHistogramBuckets; ++i) {
+    at = Put16(frame, at, stat.histogram[i]);
+  }
+  return at;
+}
+
+}  // namespace
+
+void SensorStatsBegin(SensorStats *stats, const size_t count,
+                      const uint32_t responseId, const bool useExtendedIds) {
+  gStats = stats;
+  gStatsCount = count;
+  gResponseId = responseId;
+  gUseExtendedIds = useExtendedIds;
+  SensorStatsReset();
+}
+
+void SensorStatsReset() {
+  if (gStats != nullptr) {
+    memset(gStats, 0, gStatsCount * sizeof(SensorStats));
+  }
+}
+
+void SensorStatsRecordPoll(const size_t index, const uint32_t latenessMs,
+                           const uint32_t sampleUs) {
+  if (index >= gStatsCount) {
+    return;
+  }
+  SensorStats &stats = gStats[index];
+  const bool first = stats.polls == 0U;
+  Increment(stats.polls);
+  Record(stats.latenessMs, latenessMs, first, 0);
+  Record(stats.sampleUs, sampleUs, first, kSampleHistogramShift);
+}
+
+void SensorStatsRecordTx(const size_t index, const SensorTxOutcome outcome) {
+  if (index >= gStatsCount) {
+    return;
+  }
+  SensorStats &stats = gStats[index];
+  switch (outcome) {
+    case SensorTxOutcome::Sent:
+      Increment(stats.txOk);
+      break;
+    case SensorTxOutcome::Failed:
+      Increment(stats.txFailed);
+      break;
+    case SensorTxOutcome::Skipped:
+      Increment(stats.skipped);
+      break;
+    case SensorTxOutcome::Suppressed:
+      if (stats.suppressed < UINT16_MAX) {
+        ++stats.suppressed;
+      }
+      break;
+  }
+}
+
+bool SensorStatsBuildFrame(const size_t index, CANFDMessage &outFrame) {
+  if (index >= gStatsCount) {
+    return false;
+  }
+  const SensorStats &stats = gStats[index];
+  outFrame.id = gResponseId;
+  outFrame.ext = gUseExtendedIds;
+  outFrame.len = 64;
+  memset(outFrame.data, 0, sizeof(outFrame.data));
+  outFrame.data[0] = static_cast<uint8_t>(index);
+  outFrame.data[1] = static_cast<uint8_t>(gStatsCount);
+  uint8_t at = Put32(outFrame, 2, stats.polls);
+  at = PutTiming(outFrame, at, stats.latenessMs, stats.polls);
+  at = PutTiming(outFrame, at, stats.sampleUs, stats.polls);
+  at = Put32(outFrame, at, stats.txOk);
+  at = Put32(outFrame, at, stats.txFailed);
+  at = Put32(outFrame, at, stats.skipped);
+  at = PutHistogram(outFrame, at, stats.latenessMs);
+  at = PutHistogram(outFrame, at, stats.sampleUs);
+  Put16(outFrame, at, stats.suppressed);
+  return true;
+}
+#endif
@@ -0,0 +1,129 @@
+// Host tests for protothread.h: drives a task through PT_WAIT_UNTIL,
+// PT_WAIT_MS, PT_YIELD and PT_EXIT with a fake clock. Run with
+// `pio test -e native`.
+
+#include <protothread.h>
+#include <unity.h>
+
+namespace {
+
+// Value-initializes to Pending, like SensorCollectResult.
+enum class Result : uint8_t { Pending, Ready, Failed };
+
+uint32_t gNowMs = 0;
+bool gBusDone = false;
+bool gFail = false;
+int gSteps = 0;  // Body sections reached.
+
+Result Task(Protothread &pt) {
+  PT_BEGIN(pt);
+  ++gSteps;
+  PT_WAIT_UNTIL(pt, gBusDone);
+  ++gSteps;
+  PT_WAIT_MS(pt, gNowMs, 10);
+  ++gSteps;
+  if (gFail) {
+    PT_EXIT(pt, Result::Failed);
+  }
+  PT_YIELD(pt);
+  ++gSteps;
+  PT_END(pt, Result::Ready);
+}
+
+// Runs the task up to its PT_WAIT_MS, started at startMs.
+void RunToDelay(Protothread &pt, const uint32_t startMs) {
+  gNowMs = startMs;
+  gBusDone = true;
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL_INT(2, gSteps);
+}
+
+}  // namespace
+
+void setUp() {
+  gNowMs = 0;
+  gBusDone = false;
+  gFail = false;
+  gSteps = 0;
+}
+void tearDown() {}
+
+void test_wait_until_blocks_until_condition() {
+  Protothread pt{};
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL_INT(1, gSteps);  // The body before the wait ran once.
+  gBusDone = true;
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL_INT(2, gSteps);
+}
+
+void test_wait_ms_counts_from_first_call() {
+  Protothread pt{};
+  RunToDelay(pt, 100);
+  gNowMs = 109;
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL_INT(2, gSteps);
+  gNowMs = 110;
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));  // Now at the yield.
+  TEST_ASSERT_EQUAL_INT(3, gSteps);
+  TEST_ASSERT_EQUAL(Result::Ready, Task(pt));
+  TEST_ASSERT_EQUAL_INT(4, gSteps);
+}
+
+void test_wait_ms_survives_clock_wrap() {
+  Protothread pt{};
+  RunToDelay(pt, UINT32_MAX - 4U);
+  gNowMs = 4;  // 9 ms later.
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL_INT(2, gSteps);
+  gNowMs = 5;
+  Task(pt);
+  TEST_ASSERT_EQUAL_INT(3, gSteps);
+}
+
+void test_end_restarts_the_body() {
+  Protothread pt{};
+  RunToDelay(pt, 0);
+  gNowMs = 10;
+  Task(pt);
+  TEST_ASSERT_EQUAL(Result::Ready, Task(pt));
+  gSteps = 0;
+  gBusDone = false;
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL_INT(1, gSteps);
+}
+
+void test_exit_returns_result_and_restarts() {
+  Protothread pt{};
+  gFail = true;
+  RunToDelay(pt, 0);
+  gNowMs = 10;
+  TEST_ASSERT_EQUAL(Result::Failed, Task(pt));
+  TEST_ASSERT_EQUAL_INT(0, pt.resumeLine);
+  gSteps = 0;
+  gBusDone = false;
+  Task(pt);
+  TEST_ASSERT_EQUAL_INT(1, gSteps);
+}
+
+void test_reset_abandons_a_wait() {
+  Protothread pt{};
+  RunToDelay(pt, 0);
+  ProtothreadReset(pt);
+  gSteps = 0;
+  gBusDone = false;
+  TEST_ASSERT_EQUAL(Result::Pending, Task(pt));
+  TEST_ASSERT_EQUAL_INT(1, gSteps);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_wait_until_blocks_until_condition);
+  RUN_TEST(test_wait_ms_counts_from_first_call);
+  RUN_TEST(test_wait_ms_survives_clock_wrap);
+  RUN_TEST(test_end_restarts_the_body);
+  RUN_TEST(test_exit_returns_result_and_restarts);
+  RUN_TEST(test_reset_abandons_a_wait);
+  return UNITY_END();
+}
@@ -0,0 +1,172 @@
+// Host accuracy checks and throughput benchmarks for fixed_point_filter.h.
+// Run with `pio test -e native`. Accuracy is measured against a
+// double-precision reference of the same filter; throughput is printed in ns
+// per update on the host, which is only meaningful relative to the other
+// filters (the AVR has no multiplier wider than 8x8 and no FPU).
+
+#include <fixed_point_filter.h>
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+
+#include <chrono>
+
+namespace {
+
+constexpr int kSamples = 4000;
+constexpr double kSampleHz = 1000;
+
+// Deterministic test signal: a 12-bit reading with a slow sine, a step and
+// +-32 counts of noise.
+int16_t Signal(const int i) {
+  const uint32_t seed = static_cast<uint32_t>(i) * 1103515245UL + 12345UL;
+  const int noise = static_cast<int>((seed >> 16) % 65) - 32;
+  const double sine = 600 * sin(2 * M_PI * 2 * i / kSampleHz);
+  const double step = i >= kSamples / 2 ? 800 : 0;
+  return static_cast<int16_t>(1500 + sine + step + noise);
+}
+
+template <typename Filter>
+double Benchmark(Filter &filter, const char *name) {
+  constexpr long kUpdates = 2000000L;
+  volatile int32_t sink = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < kUpdates; ++i) {
+    sink += filter.update(static_cast<int16_t>(i & 0x0FFF));
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const double ns =
+      std::chrono::duration<double, std::nano>(end - start).count() /
+      kUpdates;
+  char message[80];
+  snprintf(message, sizeof(message), "%s: %.2f ns/update (host)", name, ns);
+  TEST_MESSAGE(message);
+  return ns;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_moving_average_matches_reference() {
+  MovingAverageFilter<8> filter;
+  int16_t window[8];
+  int maxError = 0;
+  for (int i = 0; i < kSamples; ++i) {
+    const int16_t x = Signal(i);
+    if (i == 0) {
+      for (int16_t &slot : window) {
+        slot = x;
+      }
+    }
+    window[i % 8] = x;
+    double sum = 0;
+    for (const int16_t slot : window) {
+      sum += slot;
+    }
+    const int error = abs(filter.update(x) - static_cast<int>(sum / 8));
+    maxError = error > maxError ? error : maxError;
+  }
+  TEST_ASSERT_INT_WITHIN(1, 0, maxError);
+}
+
+void test_exponential_matches_reference() {
+  constexpr uint8_t kShift = EmaShiftFor(10, kSampleHz);
+  ExponentialFilter<kShift> filter;
+  const double alpha = 1.0 / (1 << kShift);
+  double reference = Signal(0);
+  int maxError = 0;
+  for (int i = 0; i < kSamples; ++i) {
+    const int16_t x = Signal(i);
+    reference += alpha * (x - reference);
+    const int error = static_cast<int>(fabs(filter.update(x) - reference));
+    maxError = error > maxError ? error : maxError;
+  }
+  TEST_ASSERT_INT_WITHIN(1, 0, maxError);
+}
+
+void test_biquad_low_pass_tracks_reference() {
+  constexpr BiquadCoefficients kCoefficients = BiquadLowPass(20, kSampleHz);
+  BiquadFilter filter(kCoefficients);
+  // Reference uses the same (rounded) coefficients in double precision, so
+  // the difference is the fixed-point arithmetic alone.
+  const double scale = 1 << kBiquadFractionBits;
+  const double b0 = kCoefficients.b0 / scale, b1 = kCoefficients.b1 / scale;
+  const double b2 = kCoefficients.b2 / scale, a1 = kCoefficients.a1 / scale;
+  const double a2 = kCoefficients.a2 / scale;
+  double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+  int maxError = 0;
+  for (int i = 0; i < kSamples; ++i) {
+    const int16_t x = Signal(i);
+    const double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+    x2 = x1;
+    x1 = x;
+    y2 = y1;
+    y1 = y;
+    const int error = static_cast<int>(fabs(filter.update(x) - y));
+    maxError = error > maxError ? error : maxError;
+  }
+  TEST_ASSERT_INT_WITHIN(2, 0, maxError);
+}
+
+void test_biquad_low_pass_has_unity_dc_gain() {
+  BiquadFilter filter(BiquadLowPass(5, kSampleHz));
+  int16_t y = 0;
+  for (int i = 0; i < kSamples; ++i) {
+    y = filter.update(4000);
+  }
+  TEST_ASSERT_INT_WITHIN(1, 4000, y);
+}
+
+void test_biquad_clamps_oversized_input() {
+  BiquadFilter filter(BiquadLowPass(5, kSampleHz));
+  int16_t y = 0;
+  for (int i = 0; i < kSamples; ++i) {
+    y = filter.update(INT16_MAX);
+  }
+  TEST_ASSERT_INT_WITHIN(1, kBiquadMaxInput, y);
+}
+
+void test_biquad_design_range() {
+  static_assert(BiquadDesignValid(20, kSampleHz), "20 Hz low-pass");
+  static_assert(BiquadDesignValid(5, kSampleHz, 0.7071, true),
+                "5 Hz high-pass");
+  TEST_ASSERT_FALSE(BiquadDesignValid(0, kSampleHz));
+  TEST_ASSERT_FALSE(BiquadDesignValid(kSampleHz / 2, kSampleHz));
+  // A sharp peak just below Nyquist puts a1 at +2.0, which is 32768 in Q14.
+  TEST_ASSERT_FALSE(BiquadDesignValid(499.9, kSampleHz, 100));
+}
+
+void test_median_rejects_spike() {
+  MedianFilter<5> filter;
+  for (int i = 0; i < 5; ++i) {
+    filter.update(100);
+  }
+  TEST_ASSERT_EQUAL_INT16(100, filter.update(4095));
+  TEST_ASSERT_EQUAL_INT16(100, filter.update(100));
+}
+
+void test_throughput() {
+  MovingAverageFilter<8> average;
+  ExponentialFilter<4> exponential;
+  BiquadFilter biquad(BiquadLowPass(20, kSampleHz));
+  MedianFilter<5> median;
+  TEST_ASSERT_TRUE(Benchmark(average, "MovingAverageFilter<8>") > 0);
+  TEST_ASSERT_TRUE(Benchmark(exponential, "ExponentialFilter<4>") > 0);
+  TEST_ASSERT_TRUE(Benchmark(biquad, "BiquadFilter") > 0);
+  TEST_ASSERT_TRUE(Benchmark(median, "MedianFilter<5>") > 0);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_moving_average_matches_reference);
+  RUN_TEST(test_exponential_matches_reference);
+  RUN_TEST(test_biquad_low_pass_tracks_reference);
+  RUN_TEST(test_biquad_low_pass_has_unity_dc_gain);
+  RUN_TEST(test_biquad_clamps_oversized_input);
+  RUN_TEST(test_biquad_design_range);
+  RUN_TEST(test_median_rejects_spike);
+  RUN_TEST(test_throughput);
+  return UNITY_END();
+}